@@ -0,0 +1,288 @@
+"""
+Export pipeline (ColumnTransformer + XGBClassifier) + label encoder sang file JSON
+"flat-trees-v1" để server C++ (TreeModel) tự chạy inference, không cần gọi Flask.
+
+    python export_model.py [--model ...] [--encoder ...] [--out models/scheduler_tree.json]
+
+Format: tiền xử lý -> danh sách feature (affine cho số, so sánh bằng cho one-hot),
+cây phẳng thành mảng node (feature, threshold, left, right, value), lá tự trỏ về chính nó.
+Cuối cùng so dự đoán của model gốc với evaluator phẳng trên dữ liệu ngẫu nhiên.
+"""
+import argparse
+import json
+import math
+import os
+import random
+
+import joblib
+import pandas as pd
+
+BASE_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# Đúng thứ tự AIFeatures bên C++
+INPUTS = [
+    "cpu",
+    "queue_len",
+    "queue_bin",
+    "request_method",
+    "request_path_length",
+    "estimated_workload",
+    "req_size",
+]
+CATEGORICAL = {"queue_bin", "request_method"}
+
+
+def compute_queue_bin(q: int) -> int:
+    if q <= 5:   return 0
+    if q <= 20:  return 1
+    if q <= 50:  return 2
+    if q <= 100: return 3
+    if q <= 200: return 4
+    if q <= 400: return 5
+    return 6
+
+
+# -----------------------------
+# Tiền xử lý -> danh sách feature
+# -----------------------------
+def _columns(cols):
+    if isinstance(cols, str):
+        return [cols]
+    return list(cols)
+
+
+def _transformer_features(trans, cols):
+    """Feature đầu ra của 1 transformer (có thể là Pipeline) trên các cột cols."""
+    if trans == "drop":
+        return []
+    if trans == "passthrough":
+        return [{"input": c, "mul": 1.0, "add": 0.0} for c in cols]
+
+    steps = trans.steps if hasattr(trans, "steps") else [(None, trans)]
+    feats = [{"input": c, "mul": 1.0, "add": 0.0} for c in cols]
+
+    for _, step in steps:
+        kind = type(step).__name__
+        if kind == "SimpleImputer":
+            continue  # C++ không có giá trị thiếu
+        if kind == "StandardScaler":
+            mean = step.mean_ if step.mean_ is not None else [0.0] * len(feats)
+            scale = step.scale_ if step.scale_ is not None else [1.0] * len(feats)
+            for f, m, s in zip(feats, mean, scale):
+                f["add"] = (f["add"] - float(m)) / float(s)
+                f["mul"] = f["mul"] / float(s)
+            continue
+        if kind == "MinMaxScaler":
+            for f, s, m in zip(feats, step.scale_, step.min_):
+                f["add"] = f["add"] * float(s) + float(m)
+                f["mul"] = f["mul"] * float(s)
+            continue
+        if kind == "OneHotEncoder":
+            out = []
+            drop_idx = getattr(step, "drop_idx_", None)
+            for i, (f, cats) in enumerate(zip(feats, step.categories_)):
+                for k, v in enumerate(cats):
+                    if drop_idx is not None and drop_idx[i] is not None and k == drop_idx[i]:
+                        continue
+                    out.append({"input": f["input"], "equals": str(v)})
+            feats = out
+            continue
+        raise SystemExit(f"Unsupported preprocessing step: {kind}")
+    return feats
+
+
+def preprocess_features(pre):
+    if pre is None:
+        return [{"input": c, "mul": 1.0, "add": 0.0} for c in INPUTS]
+
+    feats = []
+    for name, trans, cols in pre.transformers_:
+        if name == "remainder" and trans == "drop":
+            continue
+        if name == "remainder":
+            cols = [pre.feature_names_in_[i] for i in cols]
+        feats.extend(_transformer_features(trans, _columns(cols)))
+    return feats
+
+
+# -----------------------------
+# Cây XGBoost -> mảng phẳng
+# -----------------------------
+def _base_score(booster):
+    cfg = json.loads(booster.save_config())
+    raw = cfg["learner"]["learner_model_param"]["base_score"]
+    raw = raw.strip("[]").split(",")[0]
+    return float(raw)
+
+
+def flatten_trees(booster, n_groups, feat_names):
+    index = {name: i for i, name in enumerate(feat_names)}
+
+    def feature_index(split):
+        if split in index:
+            return index[split]
+        if split.startswith("f") and split[1:].isdigit():
+            return int(split[1:])
+        raise SystemExit(f"Unknown split feature: {split}")
+
+    nodes = {"feature": [], "threshold": [], "left": [], "right": [], "value": []}
+    tree_root, tree_depth, tree_group = [], [], []
+
+    for t, dump in enumerate(booster.get_dump(dump_format="json")):
+        root = json.loads(dump)
+        base = len(nodes["feature"])
+        # nodeid trong dump -> vị trí trong mảng (đánh số lại theo BFS)
+        order, queue = [], [root]
+        while queue:
+            n = queue.pop(0)
+            order.append(n)
+            queue.extend(n.get("children", []))
+        pos = {n["nodeid"]: base + i for i, n in enumerate(order)}
+
+        depth = 0
+        for n in order:
+            me = pos[n["nodeid"]]
+            if "leaf" in n:
+                nodes["feature"].append(0)
+                nodes["threshold"].append(0.0)
+                nodes["left"].append(me)
+                nodes["right"].append(me)
+                nodes["value"].append(float(n["leaf"]))
+            else:
+                nodes["feature"].append(feature_index(n["split"]))
+                nodes["threshold"].append(float(n["split_condition"]))
+                nodes["left"].append(pos[n["yes"]])
+                nodes["right"].append(pos[n["no"]])
+                nodes["value"].append(0.0)
+                depth = max(depth, n.get("depth", 0) + 1)
+
+        tree_root.append(base)
+        tree_depth.append(depth)
+        tree_group.append(t % n_groups)
+
+    return nodes, tree_root, tree_depth, tree_group
+
+
+def export(model, encoder):
+    steps = model.steps if hasattr(model, "steps") else [(None, model)]
+    clf = steps[-1][1]
+    pre = steps[0][1] if len(steps) > 1 else None
+
+    if not hasattr(clf, "get_booster"):
+        raise SystemExit(f"Only XGBoost classifiers are supported, got {type(clf).__name__}")
+
+    booster = clf.get_booster()
+    n_classes = int(clf.n_classes_)
+    n_groups = n_classes if n_classes > 2 else 1
+
+    feats = preprocess_features(pre)
+    feat_names = booster.feature_names or [f"f{i}" for i in range(len(feats))]
+    nodes, roots, depths, groups = flatten_trees(booster, n_groups, feat_names)
+
+    if encoder is not None:
+        classes = [str(c) for c in encoder.classes_]
+    else:
+        classes = [str(c) for c in clf.classes_]
+
+    base = _base_score(booster)
+    if n_groups == 1:
+        # binary:logistic: margin = logit(base_score) + tổng lá, > 0 -> class 1
+        base = math.log(base / (1.0 - base))
+
+    return {
+        "format": "flat-trees-v1",
+        "inputs": INPUTS,
+        "features": feats,
+        "classes": classes,
+        "groups": n_groups,
+        "base_margin": [base] * n_groups,
+        "tree_root": roots,
+        "tree_depth": depths,
+        "tree_group": groups,
+        "node_feature": nodes["feature"],
+        "node_threshold": nodes["threshold"],
+        "node_left": nodes["left"],
+        "node_right": nodes["right"],
+        "node_value": nodes["value"],
+    }
+
+
+# -----------------------------
+# Evaluator tham chiếu (giống TreeModel.cpp) để kiểm tra
+# -----------------------------
+def _f32(x):
+    import numpy as np
+    return float(np.float32(x))
+
+
+def flat_predict(m, row):
+    x = []
+    for f in m["features"]:
+        v = row[f["input"]]
+        if "equals" in f:
+            x.append(1.0 if str(v) == f["equals"] else 0.0)
+        else:
+            x.append(float(v) * f["mul"] + f["add"])
+
+    margin = list(m["base_margin"])
+    for root, depth, group in zip(m["tree_root"], m["tree_depth"], m["tree_group"]):
+        i = root
+        for _ in range(depth):
+            go_left = _f32(x[m["node_feature"][i]]) < _f32(m["node_threshold"][i])
+            i = m["node_left"][i] if go_left else m["node_right"][i]
+        margin[group] += m["node_value"][i]
+
+    if m["groups"] == 1:
+        return 1 if margin[0] > 0 else 0
+    return max(range(len(margin)), key=lambda k: margin[k])
+
+
+def random_row(rng):
+    q = rng.randint(0, 600)
+    return {
+        "cpu": rng.uniform(0, 100),
+        "queue_len": q,
+        "queue_bin": str(compute_queue_bin(q)),
+        "request_method": rng.choice(["GET", "POST", "PUT", "DELETE", "HEAD"]),
+        "request_path_length": rng.randint(1, 120),
+        "estimated_workload": float(rng.randint(1, 400)),
+        "req_size": rng.randint(0, 1 << 20),
+    }
+
+
+def check(model, m, n=2000):
+    rng = random.Random(0)
+    rows = [random_row(rng) for _ in range(n)]
+    expected = model.predict(pd.DataFrame(rows))
+    mismatch = sum(1 for r, e in zip(rows, expected) if flat_predict(m, r) != int(e))
+    return mismatch
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--model", default=os.getenv("MODEL_PATH", os.path.join(BASE_DIR, "models", "xgb_scheduler_v2.joblib")))
+    ap.add_argument("--encoder", default=os.getenv("ENCODER_PATH", os.path.join(BASE_DIR, "models", "label_encoder_scheduler_v2.joblib")))
+    ap.add_argument("--out", default=os.path.join(BASE_DIR, "models", "scheduler_tree.json"))
+    ap.add_argument("--no-check", action="store_true")
+    args = ap.parse_args()
+
+    model = joblib.load(args.model)
+    encoder = joblib.load(args.encoder) if os.path.exists(args.encoder) else None
+
+    m = export(model, encoder)
+
+    if not args.no_check:
+        bad = check(model, m)
+        if bad:
+            raise SystemExit(f"Flattened model disagrees with original on {bad} rows")
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    with open(args.out, "w") as f:
+        json.dump(m, f, separators=(",", ":"))
+
+    print(f"[EXPORT] {len(m['tree_root'])} trees, {len(m['node_feature'])} nodes, "
+          f"{len(m['features'])} features, classes={m['classes']} -> {args.out}")
+
+
+if __name__ == "__main__":
+    main()
@@ -3,22 +3,35 @@
 #include <string>
 #include <cstddef>
 
+// Snapshot feature gửi cho model. Trivially copyable (method là chuỗi tĩnh)
+// để đi qua mailbox seqlock của AIPredictor.
 struct AIFeatures {
     double cpu;
     std::size_t queue_len;
     int queue_bin;
-    std::string request_method;
+    const char* request_method;
     int request_path_length;
     double estimated_workload;
     std::size_t req_size;
 };
 
+// Client HTTP tới AI server. Giữ 1 curl handle keep-alive (tái dùng TCP connection),
+// nên không thread-safe: chỉ 1 thread (AIPredictor) gọi predict().
 class AIClient {
 public:
     AIClient(std::string url, long timeoutMs);
-    std::optional<std::string> predict(const AIFeatures& f) const;
+    ~AIClient();
+
+    AIClient(const AIClient&) = delete;
+    AIClient& operator=(const AIClient&) = delete;
+
+    std::optional<std::string> predict(const AIFeatures& f);
 
 private:
     std::string url_;
     long timeoutMs_;
+
+    void* curl_ = nullptr;           // CURL*
+    void* headers_ = nullptr;        // curl_slist*
+    std::string response_;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ai/AIClient.hpp"
+#include "scheduler/EventCount.hpp"
+#include "scheduler/Task.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Gọi AI server ngoài đường nóng: enqueue chỉ post() snapshot feature vào mailbox
+// (seqlock 1 slot, bản mới đè bản cũ) và đọc khuyến nghị mới nhất qua 1 atomic.
+// Thread riêng lấy snapshot mới nhất, gọi model (curl keep-alive), publish kết quả;
+// giữa 2 lần gọi cách nhau tối thiểu minInterval.
+class AIPredictor {
+public:
+    AIPredictor(std::string url, long timeoutMs, std::chrono::milliseconds minInterval);
+    ~AIPredictor();
+
+    AIPredictor(const AIPredictor&) = delete;
+    AIPredictor& operator=(const AIPredictor&) = delete;
+
+    // 1 predictor cho cả process, sống khi còn scheduler adaptive giữ nó
+    static std::shared_ptr<AIPredictor> shared();
+
+    // Không block: writer khác đang ghi -> bỏ snapshot này (bản kia cũng mới như vậy)
+    void post(const AIFeatures& f);
+
+    // Khuyến nghị mới nhất; false nếu chưa có hoặc đã cũ hơn STALE_AFTER
+    bool recommendation(SchedAlgo& out) const;
+
+    struct Stats {
+        std::uint64_t posted = 0;
+        std::uint64_t dropped = 0;       // post trùng lúc writer khác
+        std::uint64_t predictions = 0;   // gọi model thành công
+        std::uint64_t failures = 0;
+        std::uint64_t lastLatencyUs = 0;
+        int recommended = -1;            // SchedAlgo, -1 = chưa có
+    };
+    Stats stats() const;
+
+    static constexpr std::chrono::milliseconds STALE_AFTER{2000};
+
+private:
+    void run();
+    // Đọc snapshot nhất quán, trả về seq của nó
+    std::uint64_t readMailbox(AIFeatures& out) const;
+
+    AIClient client_;
+    std::chrono::milliseconds minInterval_;
+
+    // Mailbox seqlock: seq lẻ = đang ghi
+    static constexpr std::size_t WORDS = (sizeof(AIFeatures) + 7) / 8;
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> words_[WORDS] = {};
+    EventCount posted_;
+
+    // Kết quả publish: algo + thời điểm (ns steady_clock)
+    std::atomic<int> recommended_{-1};
+    std::atomic<std::int64_t> publishedAtNs_{0};
+
+    std::atomic<std::uint64_t> postCount_{0};
+    std::atomic<std::uint64_t> dropCount_{0};
+    std::atomic<std::uint64_t> predictCount_{0};
+    std::atomic<std::uint64_t> failCount_{0};
+    std::atomic<std::uint64_t> lastLatencyUs_{0};
+
+    std::atomic<bool> stop_{false};
+    std::mutex stopMtx_;
+    std::condition_variable stopCv_;
+    std::thread thread_;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ai/AIClient.hpp"
+#include "scheduler/Task.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Inference cây (XGBoost) ngay trong process, đọc file "flat-trees-v1" do
+// ai/export_model.py sinh ra. Duyệt cây không rẽ nhánh: lá tự trỏ về chính nó,
+// mỗi cây đi đúng `depth` bước, mỗi bước chọn con bằng chỉ số (x < thr).
+// Load 1 lần, sau đó chỉ đọc -> predict() gọi song song được.
+class TreeModel {
+public:
+    // false + log nếu file thiếu / sai format
+    bool load(const std::string& path);
+
+    bool loaded() const { return !roots_.empty(); }
+    std::size_t treeCount() const { return roots_.size(); }
+    std::size_t nodeCount() const { return nodes_.size(); }
+
+    // false nếu chưa load hoặc class dự đoán không phải tên thuật toán
+    bool predict(const AIFeatures& f, SchedAlgo& out) const;
+
+    // Model dùng chung; đường dẫn lấy từ SCHED_MODEL_PATH, mặc định ai/models/scheduler_tree.json
+    static std::shared_ptr<const TreeModel> shared();
+
+private:
+    // Chỉ số input trong AIFeatures (đúng thứ tự INPUTS của exporter)
+    enum Input : std::uint8_t {
+        CPU, QUEUE_LEN, QUEUE_BIN, REQUEST_METHOD, PATH_LENGTH, EST_WORKLOAD, REQ_SIZE, INPUT_COUNT
+    };
+
+    // Feature sau tiền xử lý: affine (x*mul + add) hoặc one-hot (input == value)
+    struct Feature {
+        Input input;
+        bool oneHot;
+        double mul, add;
+        double equalsNum;       // one-hot trên input số (queue_bin)
+        std::string equalsStr;  // one-hot trên request_method
+    };
+
+    struct Node {
+        float threshold;
+        std::uint32_t feature;
+        std::uint32_t child[2];  // [0] = x < threshold, [1] = ngược lại
+        float value;             // chỉ có nghĩa ở lá
+    };
+
+    std::vector<Feature> features_;
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> roots_;
+    std::vector<std::uint8_t> depths_;
+    std::vector<std::uint16_t> groups_;
+    std::vector<float> baseMargin_;
+
+    // class index -> thuật toán (valid_ = false nếu tên class lạ)
+    std::vector<SchedAlgo> classAlgo_;
+    std::vector<bool> classValid_;
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Giải mã body Transfer-Encoding: chunked theo kiểu tăng dần (RFC 9112 §7.1).
+// Input tới từng mảnh bất kỳ; state giữ lại giữa các lần feed().
+// Data không bị copy ở đây: callback nhận con trỏ vào chính input.
+class ChunkedDecoder {
+public:
+    enum class Status {
+        NeedMore,  // đã dùng hết input, chờ thêm
+        Done,      // đã gặp chunk 0 + trailer
+        Error      // sai cú pháp, chunk quá lớn hoặc callback từ chối
+    };
+
+    // Giới hạn trailer (header sau chunk cuối), bỏ qua nội dung
+    static constexpr std::size_t MAX_TRAILER_BYTES = 8192;
+
+    // Dùng [in, in + len); consumed = số byte input đã xử lý.
+    // out(const char* data, size_t n) -> false để dừng (vd vượt giới hạn body)
+    template <typename Out>
+    Status feed(const char* in, std::size_t len, std::size_t& consumed, Out&& out);
+
+    void reset() { *this = ChunkedDecoder(); }
+
+private:
+    enum class State { Size, Ext, SizeLF, Data, DataCR, DataLF, Trailer, TrailerLine, TrailerLF, Done };
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    State state = State::Size;
+    std::uint64_t remaining = 0;  // Size: kích thước đang đọc; Data: số byte còn lại của chunk
+    int digits = 0;
+    std::size_t trailerBytes = 0;
+};
+
+template <typename Out>
+ChunkedDecoder::Status ChunkedDecoder::feed(const char* in, std::size_t len, std::size_t& consumed,
+                                            Out&& out) {
+    std::size_t i = 0;
+
+    while (i < len && state != State::Done) {
+        char c = in[i];
+
+        switch (state) {
+        case State::Size: {
+            int v = hexValue(c);
+            if (v >= 0) {
+                // 15 chữ số hex (~1 PB) là quá đủ, nhiều hơn coi như tấn công
+                if (++digits > 15) return Status::Error;
+                remaining = remaining * 16 + (std::uint64_t)v;
+                ++i;
+            } else if (digits == 0) {
+                return Status::Error;
+            } else if (c == ';' || c == ' ' || c == '\t') {
+                state = State::Ext;
+                ++i;
+            } else if (c == '\r') {
+                state = State::SizeLF;
+                ++i;
+            } else if (c == '\n') {
+                state = State::SizeLF;  // chấp nhận LF trơn, xử lý như CRLF
+            } else {
+                return Status::Error;
+            }
+            break;
+        }
+        case State::Ext:
+            // chunk-ext: bỏ qua tới hết dòng
+            if (c == '\r') state = State::SizeLF;
+            else if (c == '\n') { state = State::SizeLF; break; }
+            ++i;
+            break;
+        case State::SizeLF:
+            if (c != '\n') return Status::Error;
+            ++i;
+            digits = 0;
+            state = remaining == 0 ? State::Trailer : State::Data;
+            break;
+        case State::Data: {
+            std::size_t n = (std::size_t)std::min<std::uint64_t>(remaining, len - i);
+            if (!out(in + i, n)) return Status::Error;
+            i += n;
+            remaining -= n;
+            if (remaining == 0) state = State::DataCR;
+            break;
+        }
+        case State::DataCR:
+            if (c == '\r') { state = State::DataLF; ++i; }
+            else if (c == '\n') state = State::DataLF;
+            else return Status::Error;
+            break;
+        case State::DataLF:
+            if (c != '\n') return Status::Error;
+            ++i;
+            state = State::Size;
+            break;
+        case State::Trailer:
+            // Đầu dòng trailer: dòng trống = kết thúc body
+            if (c == '\r') { state = State::TrailerLF; ++i; }
+            else if (c == '\n') { state = State::Done; ++i; }
+            else state = State::TrailerLine;
+            break;
+        case State::TrailerLine:
+            if (++trailerBytes > MAX_TRAILER_BYTES) return Status::Error;
+            if (c == '\n') state = State::Trailer;
+            ++i;
+            break;
+        case State::TrailerLF:
+            if (c != '\n') return Status::Error;
+            ++i;
+            state = State::Done;
+            break;
+        case State::Done:
+            break;
+        }
+    }
+
+    consumed = i;
+    return state == State::Done ? Status::Done : Status::NeedMore;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "core/Response.hpp"
+
+struct Connection;
+
+// Gửi response theo kiểu stream trong lúc handler vẫn đang tạo dữ liệu.
+//  - HTTP/1.1: Transfer-Encoding: chunked, mỗi lần buffer đầy -> 1 chunk
+//  - HTTP/1.0: không có chunked -> gửi thẳng body, kết thúc bằng đóng connection
+// Bộ nhớ cố định (buffer gom các write nhỏ), không cần biết trước tổng độ dài.
+class ChunkedWriter {
+public:
+    static constexpr std::size_t DEFAULT_BUFFER = 16 * 1024;
+
+    ChunkedWriter(Connection& conn, bool chunked, std::size_t bufferSize = DEFAULT_BUFFER);
+
+    // Gửi status line + header (res.body bị bỏ qua). false nếu lỗi gửi
+    bool begin(Response& res);
+
+    // Thêm dữ liệu; buffer đầy thì flush thành 1 chunk
+    bool write(const char* data, std::size_t len);
+    bool write(std::string_view s) { return write(s.data(), s.size()); }
+
+    // Gửi ngay phần đang buffer (vd để client thấy dữ liệu sớm)
+    bool flush();
+
+    // Gửi phần còn lại + chunk cuối "0\r\n\r\n"
+    bool finish();
+
+    // Sau response này connection có giữ được không (HTTP/1.0 phải đóng)
+    bool keepAliveAllowed() const { return chunked; }
+
+private:
+    // Gửi phần đang buffer thành 1 chunk; last -> kèm chunk kết thúc
+    bool sendBuffered(bool last);
+
+    Connection& conn;
+    bool chunked;
+    std::size_t capacity;
+    std::string buffer;
+    bool failed = false;
+};
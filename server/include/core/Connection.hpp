@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "core/ChunkedDecoder.hpp"
+#include "core/HttpParser.hpp"
+
+class UploadFile;
+
+// Forward declaration cho OpenSSL
+typedef struct ssl_st SSL;
+
+// Trạng thái 1 kết nối client (fd + SSL + buffer đọc)
+// Reactor sở hữu connection cho tới khi request đọc xong,
+// sau đó chuyển sang worker để xử lý và gửi response.
+struct Connection {
+    enum class State {
+        Handshake,   // đang SSL_accept (non-blocking)
+        Reading,     // đang đọc header/body
+        Processing,  // đã giao cho scheduler/threadpool
+        Closed
+    };
+
+    int   fd  = -1;
+    SSL*  ssl = nullptr;   // nullptr = plaintext (tls tắt)
+    State state = State::Handshake;
+
+    // Event epoll đang đăng ký (tránh epoll_ctl thừa)
+    std::uint32_t epollEvents = 0;
+
+    // Dữ liệu đã đọc nhưng chưa parse
+    std::string inBuf;
+
+    // Parser tăng dần trên inBuf (nhớ chỗ đã quét, không quét lại từ đầu)
+    HttpParser  parser;
+    std::size_t headerEnd = 0;       // 0 = chưa đủ header
+    long long   contentLength = 0;
+
+    // Upload streaming: body ghi thẳng xuống file tạm thay vì inBuf
+    std::shared_ptr<UploadFile> upload;
+    long long bodyReceived = 0;
+
+    // Body chunked: giải mã dần, phần đã giải mã nằm ngay sau header (hoặc trong file upload),
+    // bodyRawPos = byte chunked đầu tiên chưa giải mã trong inBuf
+    bool chunked = false;
+    ChunkedDecoder chunkDecoder;
+    std::size_t bodyRawPos = 0;
+
+    // Byte reactor tự gửi (vd. 503 khi pool đầy): gửi không chờ, phần còn lại đợi EPOLLOUT.
+    // outPos = byte đã gửi; closeAfterOut: gửi hết thì đóng connection
+    std::string outBuf;
+    std::size_t outPos = 0;
+    bool closeAfterOut = false;
+
+    // Keep-alive: số request đã phục vụ trên connection này
+    int requestsServed = 0;
+
+    // Cho /metrics: byte đã ghi ra socket (SslIO cộng dồn) + status của response gần nhất
+    std::uint64_t bytesSent = 0;
+    int lastStatus = 0;
+
+    std::chrono::steady_clock::time_point acceptedAt;
+    std::chrono::steady_clock::time_point handshakeDoneAt;  // HTTP thường = acceptedAt
+    std::chrono::steady_clock::time_point requestStartAt;   // byte đầu của request đang đọc
+    std::chrono::steady_clock::time_point lastActive;
+
+    Connection(int fd_, SSL* ssl_);
+    ~Connection();
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    void touch() { lastActive = std::chrono::steady_clock::now(); }
+
+    // SSL_shutdown + SSL_free + close(fd), gọi nhiều lần vẫn an toàn
+    void close();
+};
@@ -1,8 +1,60 @@
 #pragma once
-#include "core/Request.hpp"
+#include <cstddef>
 #include <string>
 
+#include "core/Request.hpp"
+
+// Parser HTTP/1.1 tăng dần (resumable) chạy thẳng trên buffer đọc của connection.
+//  - Mỗi lần feed() chỉ quét phần bytes mới, dừng ở đâu thì lần sau tiếp từ đó
+//  - Không tạo std::string: method/path/header là Span trỏ vào buffer
+//  - Tìm LF / ':' bằng SSE2 (AVX2 nếu CPU hỗ trợ, chọn lúc chạy)
+// Buffer chỉ được append giữa các lần feed(); request luôn bắt đầu ở offset 0.
 class HttpParser {
 public:
-    static Request parse(const std::string& raw);
+    enum class Status {
+        Incomplete,  // chưa đủ header, chờ thêm dữ liệu
+        Done,        // đã có đủ request line + header
+        Error        // request sai cú pháp
+    };
+
+    // Số header tối đa trong 1 request
+    static constexpr std::size_t MAX_HEADERS = 100;
+
+    HttpParser() { reset(); }
+
+    Status feed(const std::string& buf);
+
+    // Bắt đầu request mới (sau khi request trước đã bị cắt khỏi buffer)
+    void reset();
+
+    // Chỉ hợp lệ khi feed() trả Done
+    std::size_t headerEnd() const { return headerEndPos; }
+    long long contentLength() const { return contentLen; }
+    // Transfer-Encoding: chunked -> body giải mã bằng ChunkedDecoder, bỏ qua Content-Length
+    bool chunked() const { return isChunked; }
+
+    // Spans + headers của request đang parse (trỏ vào buffer đã feed)
+    const Request& head() const { return req; }
+    // Chuyển kết quả ra ngoài, parser về trạng thái ban đầu
+    Request take();
+
+    // Tìm byte c trong [p, end), nullptr nếu không có (SIMD)
+    static const char* findByte(const char* p, const char* end, char c);
+
+private:
+    enum class Phase { RequestLine, Headers, Done };
+
+    bool parseRequestLine(const char* base, std::size_t b, std::size_t e);
+    bool parseHeaderLine(const char* base, std::size_t b, std::size_t e);
+
+    Phase phase = Phase::RequestLine;
+    std::size_t lineStart = 0;     // đầu dòng đang chờ LF
+    std::size_t scanPos = 0;       // đã quét tới đây, lần sau tiếp tục
+    std::size_t headerEndPos = 0;
+    long long contentLen = 0;
+    bool hasContentLength = false;
+    bool hasTransferEncoding = false;
+    bool isChunked = false;
+
+    Request req;
 };
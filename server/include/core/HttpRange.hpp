@@ -0,0 +1,40 @@
+#pragma once
+#include <sys/types.h>
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Range / If-Range (RFC 9110 §14) cho response dạng file
+namespace HttpRange {
+
+// Số range tối đa trong 1 request, nhiều hơn -> bỏ qua header Range (trả 200)
+constexpr std::size_t MAX_RANGES = 16;
+
+struct ByteRange {
+    off_t offset = 0;
+    std::size_t length = 0;
+};
+
+enum class Result {
+    Ignore,         // không có Range / sai cú pháp / đơn vị lạ -> trả cả file
+    Satisfiable,    // ranges có ít nhất 1 đoạn -> 206
+    Unsatisfiable,  // không đoạn nào nằm trong file -> 416
+};
+
+// Parse "bytes=0-99,200-,-50" theo kích thước file
+Result parse(std::string_view header, std::size_t fileSize, std::vector<ByteRange>& ranges);
+
+// Validator cho file: ETag mạnh từ size + mtime, Last-Modified dạng HTTP-date
+std::string makeETag(std::size_t size, const struct timespec& mtime);
+std::string formatHttpDate(std::time_t t);
+
+// If-Range còn khớp với bản hiện tại không (ETag so sánh mạnh, hoặc Last-Modified bằng nhau)
+bool ifRangeMatches(std::string_view ifRange, const std::string& etag, std::time_t mtime);
+
+// "bytes 0-99/1234"
+std::string contentRange(const ByteRange& r, std::size_t fileSize);
+
+}  // namespace HttpRange
@@ -1,14 +1,24 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "core/Connection.hpp"
 #include "core/Request.hpp"
 #include "core/Response.hpp"
+#include "core/ServerOptions.hpp"
 
-class Socket;
+class Reactor;
 class Scheduler;
 class ThreadPool;
 class Logger;
+class Metrics;
+class TlsSessionCache;
+class HandshakePool;
+class StaticCache;
 
 // Forward declaration cho OpenSSL
 typedef struct ssl_st SSL;
@@ -16,7 +26,8 @@ typedef struct ssl_ctx_st SSL_CTX;
 
 class HttpServer {
 public:
-    HttpServer(int port, int threadCount, const std::string& algo);
+    HttpServer(int port, int threadCount, const std::string& algo,
+               const ServerOptions& options = ServerOptions{});
     ~HttpServer();
 
     void start();
@@ -26,30 +37,81 @@ private:
     int    port;
     int    threadCount;
     bool   isRunning;
-    int    nextTaskId;
-    double latencyAvg;
+    std::atomic<int> nextTaskId;
+    std::atomic<double> latencyAvg;  // EWMA (ms), cập nhật bằng CAS từ mọi worker
+    std::atomic<std::uint64_t> overloadRejected{0};  // request bị trả 503 vì pool đầy
     std::string algoName;
+    ServerOptions options;
 
-    std::unique_ptr<Socket>    serverSocket;
+    // Logger/metrics khai báo trước shards/threadpool -> hủy sau cùng (task còn chạy vẫn ghi được)
+    std::unique_ptr<Logger> logger;
+    std::unique_ptr<Metrics> metrics;
+
+    // 1 shard = 1 reactor thread + listening socket riêng (SO_REUSEPORT)
+    struct Shard {
+        int index = 0;
+        std::unique_ptr<Reactor> reactor;
+
+        // Trỏ tới threadpool chung hoặc của riêng shard (kèm scheduler riêng)
+        ThreadPool* threadPool = nullptr;
+        std::unique_ptr<Scheduler>  ownScheduler;
+        std::unique_ptr<ThreadPool> ownThreadPool;
+
+        std::thread thread;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // Pool SSL handshake dùng chung cho mọi shard (hủy trước shards)
+    std::unique_ptr<HandshakePool> handshakePool;
+
+    // Scheduler + threadpool dùng chung (khi không shard scheduler)
     std::unique_ptr<Scheduler> scheduler;
     std::unique_ptr<ThreadPool> threadPool;
-    std::unique_ptr<Logger>    logger;
 
     // SSL context cho HTTPS
     SSL_CTX* sslCtx;
+    std::unique_ptr<TlsSessionCache> tlsCache;
+
+    // Static asset cache (response dựng sẵn) + header Connection dựng sẵn
+    std::unique_ptr<StaticCache> staticCache;
+    std::string keepAliveHeaderLines;
 
 private:
-    // Đọc HTTP request qua SSL
-    std::string readRequestBlockingSSL(SSL* ssl);
+    // Reactor gọi khi đã đọc + parse xong 1 request: tạo Task -> scheduler
+    void enqueueRequest(Shard& shard, std::shared_ptr<Connection> conn, Request req);
+
+    // Pool đầy: trả 503 + Retry-After qua đường gửi non-blocking của reactor rồi đóng connection
+    void rejectOverloaded(Reactor& reactor, std::shared_ptr<Connection> conn);
+
+    // Tạo reactor (+ scheduler/threadpool riêng nếu cần) cho từng shard
+    bool setupShards();
+    void runShard(Shard& shard);
 
     // Ước lượng workload cho scheduler
     int estimateTaskWorkload(const Request& req);
 
     // Static files, router và handler
-    bool serveStaticFile(Response& res, const std::string& path);
-    void handleClient(SSL* ssl, int clientSocketFd, const Request& req);
+    bool serveStaticFile(Response& res, std::string_view path);
+    // Static asset có trong cache: gửi thẳng response dựng sẵn, false nếu không áp dụng
+    bool sendCachedStatic(Connection& conn, const Request& req, bool keepAlive, bool& sentOk);
+    // Trả về true nếu connection được giữ lại (keep-alive)
+    // tl: đóng dấu handlerDone ngay trước khi ghi response ra socket
+    bool handleClient(Connection& conn, const Request& req, RequestTimeline& tl);
+
+    // Endpoint nội bộ: thống kê runtime (JSON)
+    void handleStats(Response& res);
+    // /metrics: Prometheus text (metrics HTTP + gauge của server)
+    void handleMetrics(Response& res);
+    // /api/trace: trace-event JSON (Chrome / Perfetto) của các ring Tracer
+    void handleTrace(Response& res);
+
+    // Stream file log bằng ChunkedWriter; false nếu lỗi gửi
+    bool streamLogs(Connection& conn, const Request& req, Response& res, int fd, bool& keepAlive);
+    bool streamLogSegments(Connection& conn, const Request& req, Response& res,
+                           const std::vector<std::string>& segments, bool& keepAlive);
 
     void handleGET(Response& res, const Request& req);
+    void serveFileApi(Response& res, const Request& req, const std::string& filePath);
     void handlePOST(Response& res, const Request& req);
     void handlePUT(Response& res, const Request& req);
     void handleDELETE(Response& res, const Request& req);
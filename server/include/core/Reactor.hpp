@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/Connection.hpp"
+#include "core/Request.hpp"
+#include "core/ServerOptions.hpp"
+
+class Socket;
+class HandshakePool;
+
+// Forward declaration cho OpenSSL
+typedef struct ssl_ctx_st SSL_CTX;
+
+// Event loop non-blocking dựa trên epoll.
+// Sở hữu listening socket và toàn bộ client fd: accept, SSL handshake và
+// đọc request đều là state machine, không thread nào bị block bởi 1 client chậm.
+// Chỉ request đã parse xong mới được giao ra ngoài qua callback.
+class Reactor {
+public:
+    using RequestCallback =
+        std::function<void(std::shared_ptr<Connection> conn, Request req)>;
+
+    // Từ method + path -> đường dẫn file đích nếu body cần stream xuống đĩa, "" = giữ trong RAM
+    using UploadTarget =
+        std::function<std::string(std::string_view method, std::string_view path)>;
+
+    // sslCtx == nullptr: HTTP thường, bỏ qua handshake
+    Reactor(SSL_CTX* sslCtx, const ServerOptions& options, RequestCallback onRequest);
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // bind + listen + đăng ký listening socket vào epoll
+    bool listen(int port);
+
+    // Có pool: SSL handshake chạy trên HandshakePool thay vì reactor thread
+    void setHandshakePool(HandshakePool* pool) { handshakePool = pool; }
+
+    // Có target: body upload được ghi dần xuống file tạm, không buffer cả body
+    void setUploadTarget(UploadTarget target) { uploadTarget = std::move(target); }
+
+    // Vòng lặp chính, chạy cho tới khi stop()
+    void run();
+
+    // Có thể gọi từ thread khác
+    void stop();
+
+    // Nhận lại connection để đọc request (thread-safe): từ HandshakePool khi
+    // handshake xong, hoặc từ worker sau khi gửi response keep-alive.
+    // Request pipelined còn trong buffer sẽ được xử lý tiếp.
+    void resume(std::shared_ptr<Connection> conn);
+
+    // Chỉ gọi trên reactor thread (vd. trong RequestCallback) với connection đã giao ra:
+    // gửi data không chờ rồi đóng. Socket đầy -> phần còn lại đợi EPOLLOUT,
+    // client không đọc thì sweepIdle đóng sau ioTimeout
+    void sendAndClose(std::shared_ptr<Connection> conn, std::string_view data);
+
+private:
+    void onAccept();
+    void onClientEvent(const std::shared_ptr<Connection>& conn, uint32_t events);
+
+    // Trả về false nếu connection phải đóng
+    bool driveHandshake(Connection& conn);
+    bool driveRead(const std::shared_ptr<Connection>& conn);
+
+    // Kiểm tra buffer đã đủ 1 request chưa; -1 = lỗi, 0 = chưa đủ, 1 = đủ
+    int checkComplete(Connection& conn);
+    // Header vừa đủ: quyết định stream body xuống file hay giữ trong RAM, false nếu phải đóng
+    bool beginBody(Connection& conn);
+    // Body Transfer-Encoding: chunked, cùng quy ước trả về với checkComplete
+    int readChunked(Connection& conn);
+    // Backlog upload đầy: bỏ connection khỏi epoll tới khi IO thread ghi kịp, true nếu đã dừng
+    bool pauseUpload(const std::shared_ptr<Connection>& conn);
+    void dispatch(const std::shared_ptr<Connection>& conn);
+
+    // Gửi tiếp outBuf không chờ. false nếu lỗi; waitEvents = event cần đợi, 0 = đã gửi hết
+    bool flushOut(Connection& conn, uint32_t& waitEvents);
+
+    void drainResumed();
+
+    void watch(Connection& conn, uint32_t events, bool add);
+    void closeConnection(int fd);
+    void sweepIdle();
+
+    SSL_CTX* sslCtx;
+    HandshakePool* handshakePool = nullptr;
+    ServerOptions options;
+    RequestCallback onRequest;
+    UploadTarget uploadTarget;
+
+    std::unique_ptr<Socket> listenSocket;
+    int epollFd = -1;
+    int wakeFd  = -1;  // eventfd để stop() đánh thức epoll_wait
+
+    std::atomic<bool> running{false};
+
+    std::unordered_map<int, std::shared_ptr<Connection>> conns;
+
+    // Connection worker trả về, chờ reactor nhận lại
+    std::mutex resumeMtx;
+    std::vector<std::shared_ptr<Connection>> resumed;
+};
@@ -1,15 +1,64 @@
 #pragma once
+#include <strings.h>
+#include <cstddef>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
+#include "core/RequestTimeline.hpp"
+
+class UploadFile;
+
+// Request đã parse. Không tách ra std::string cho từng phần:
+// `raw` giữ nguyên bytes request (request line + header + body nếu giữ trong RAM),
+// method/path/header... chỉ là (offset, length) trỏ vào raw -> copy/move vẫn đúng.
 class Request {
 public:
-    std::string method;
-    std::string path;
-    std::string version;
+    struct Span {
+        std::size_t off = 0;
+        std::size_t len = 0;
+    };
+    struct Header {
+        Span name;
+        Span value;
+    };
+
+    std::string raw;
+
+    Span methodSpan;
+    Span pathSpan;
+    Span versionSpan;
+    Span bodySpan;
+    std::vector<Header> headers;
 
-    std::unordered_map<std::string, std::string> headers;
-    std::string body;
+    // Upload streaming (PUT/POST file): body đã nằm trong file tạm, không ở raw
+    std::shared_ptr<UploadFile> upload;
+
+    // Mốc thời gian từng giai đoạn (reactor -> scheduler -> worker)
+    RequestTimeline timeline;
 
     Request() = default;
+
+    std::string_view method() const { return slice(raw, methodSpan); }
+    std::string_view path() const { return slice(raw, pathSpan); }
+    std::string_view version() const { return slice(raw, versionSpan); }
+    std::string_view body() const { return slice(raw, bodySpan); }
+
+    // Giá trị header (không phân biệt hoa/thường tên), rỗng nếu không có
+    std::string_view header(std::string_view name) const { return headerIn(raw, name); }
+
+    // Dùng khi bytes còn nằm trong buffer của connection (chưa chuyển vào raw)
+    static std::string_view slice(const std::string& base, Span s) {
+        return std::string_view(base.data() + s.off, s.len);
+    }
+    std::string_view headerIn(const std::string& base, std::string_view name) const {
+        for (const auto& h : headers) {
+            if (h.name.len == name.size() &&
+                strncasecmp(base.data() + h.name.off, name.data(), name.size()) == 0) {
+                return slice(base, h.value);
+            }
+        }
+        return std::string_view();
+    }
 };
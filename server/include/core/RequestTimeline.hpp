@@ -0,0 +1,34 @@
+#pragma once
+#include <chrono>
+
+// Mốc thời gian (steady_clock) của 1 request qua từng giai đoạn, đi kèm Request
+// từ reactor tới worker. Mốc chưa đóng dấu = time_point{} -> khoảng tương ứng = 0.
+struct RequestTimeline {
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    TimePoint accepted;       // accept() connection
+    TimePoint handshakeDone;  // TLS xong (HTTP thường = accepted)
+    TimePoint firstByte;      // byte đầu tiên của request này tới
+    TimePoint parsed;         // đủ header + body, reactor dispatch
+    TimePoint enqueued;       // vào scheduler
+    TimePoint dequeued;       // worker bắt đầu chạy task
+    TimePoint handlerDone;    // response đã dựng xong (trước khi ghi socket)
+    TimePoint flushed;        // đã ghi xong ra socket
+
+    // Request đầu tiên trên connection mới tính thời gian handshake
+    bool firstOnConnection = false;
+
+    static double ms(TimePoint from, TimePoint to) {
+        if (from == TimePoint{} || to == TimePoint{} || to < from) return 0.0;
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    double handshakeMs() const { return firstOnConnection ? ms(accepted, handshakeDone) : 0.0; }
+    double readMs() const { return ms(firstByte, parsed); }
+    double queueMs() const { return ms(enqueued, dequeued); }
+    double serviceMs() const { return ms(dequeued, handlerDone); }
+    double writeMs() const { return ms(handlerDone, flushed); }
+    // Như response_ms cũ: từ lúc vào scheduler tới khi ghi xong
+    double responseMs() const { return ms(enqueued, flushed); }
+};
@@ -1,6 +1,41 @@
 #pragma once
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+
+// Body nằm trong file đã mở (gửi zero-copy bằng sendfile/mmap).
+// Sở hữu fd, tự đóng khi hủy.
+struct FileBody {
+    int fd = -1;
+    off_t offset = 0;
+    std::size_t length = 0;
+
+    // multipart/byteranges: mỗi part = header của part + 1 đoạn file,
+    // cuối cùng là boundary đóng. Rỗng -> body chỉ là [offset, offset + length)
+    struct Part {
+        std::string head;
+        off_t offset = 0;
+        std::size_t length = 0;
+    };
+    std::vector<Part> parts;
+    std::string trailer;
+
+    FileBody(int fd_, off_t offset_, std::size_t length_)
+        : fd(fd_), offset(offset_), length(length_) {}
+    ~FileBody();
+
+    // Tổng số byte body (Content-Length)
+    std::size_t bodyLength() const;
+
+    FileBody(const FileBody&) = delete;
+    FileBody& operator=(const FileBody&) = delete;
+};
 
 class Response {
 public:
@@ -10,5 +45,33 @@ public:
     std::unordered_map<std::string, std::string> headers;
     std::string body;
 
+    // Dòng Connection (+ Keep-Alive) dựng sẵn, kết thúc bằng "\r\n", ghi nguyên văn sau headers.
+    // Trỏ vào string sống lâu hơn Response (vd. HttpServer::keepAliveHeaderLines)
+    std::string_view connectionHeaders;
+    static constexpr std::string_view CLOSE_HEADER = "Connection: close\r\n";
+
+    // Nếu có: body lấy từ file, build() chỉ tạo phần header
+    std::shared_ptr<FileBody> file;
+
+    // Body stream bằng ChunkedWriter: build() ghi Transfer-Encoding thay cho Content-Length
+    bool chunked = false;
+
+    // Body stream tới khi đóng connection (HTTP/1.0, không chunked): không ghi Content-Length
+    bool closeDelimited = false;
+
+    std::size_t contentLength() const { return file ? file->bodyLength() : body.size(); }
+
+    // Response dạng scatter-gather, không copy body:
+    //   [0] status line (dựng sẵn theo mã, mã lạ mới ghi vào scratch)
+    //   [1] header block (ghi vào scratch)
+    //   [2] body (nếu có và không phải file/chunked)
+    // iovec trỏ vào scratch và chính Response: cả hai phải còn sống tới lúc gửi xong
+    static constexpr int MAX_IOV = 3;
+    int toIovecs(iovec* iov, std::string& scratch) const;
+
+    // Ghép thành 1 string (không dùng trên đường gửi chính)
     std::string build() const;
+
+    // "HTTP/1.1 <code> <text>\r\n" dựng sẵn, rỗng nếu mã không có trong bảng
+    static std::string_view internedStatusLine(int code);
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+// Tuỳ chọn runtime cho HttpServer (đọc từ config/server.json trong main.cpp)
+struct ServerOptions {
+    // Số reactor/acceptor thread, mỗi cái 1 listening socket (SO_REUSEPORT)
+    int acceptors = 1;
+
+    // Pin reactor thứ i vào core (i % số core)
+    bool pinAcceptors = false;
+
+    // true: mỗi shard có scheduler + threadpool riêng (threads chia đều)
+    // false: mọi shard đẩy vào 1 scheduler chung
+    bool shardScheduler = false;
+
+    // true: 1 threadpool work-stealing (mỗi worker scheduler + deque riêng, worker rảnh
+    // steal của worker khác); bỏ qua shardScheduler
+    bool workStealing = false;
+
+    // HTTP/1.1 keep-alive: thời gian chờ request kế tiếp (giây)
+    // và số request tối đa trên 1 connection
+    int keepAliveTimeoutSec = 5;
+    int maxRequestsPerConn  = 100;
+
+    // Client im lặng quá lâu giữa chừng handshake/request -> đóng (giây)
+    int ioTimeoutSec = 5;
+
+    // false: HTTP thường (không TLS), response gửi bằng writev/sendfile
+    bool tls = true;
+
+    // Số thread cho SSL handshake (0 = handshake ngay trên reactor thread)
+    int handshakeThreads = 2;
+
+    // Zero-copy: file >= ngưỡng này gửi bằng kTLS/SSL_sendfile hoặc mmap
+    bool ktls = true;
+    int  zeroCopyMinBytes = 64 * 1024;
+
+    // Cache static asset trong RAM (0 = tắt); file lớn hơn maxEntry đi đường zero-copy
+    int staticCacheBytes    = 32 * 1024 * 1024;
+    int staticCacheMaxEntry = 1024 * 1024;
+
+    // Body giữ trong RAM (request thường) và body upload streaming xuống file tạm (PUT/POST file)
+    long long maxBodyBytes   = 5 * 1024 * 1024;
+    long long maxUploadBytes = 1024LL * 1024 * 1024;
+
+    // TLS session resumption: cache session-ID + session ticket
+    int tlsSessionCacheSize  = 20480;
+    int tlsSessionTimeoutSec = 300;
+    int tlsTicketRotateSec   = 3600;  // 0 = tắt session ticket
+
+    // Logger bất đồng bộ: chu kỳ thread writer gom ring và ghi file (ms)
+    int logFlushMs = 200;
+
+    // true: log nhị phân theo segment (data/logs/http_server_log.NNNNNN.bin), đủ size thì xoay
+    bool logBinary = false;
+    long long logSegmentBytes = 64LL * 1024 * 1024;
+
+    // Trace span (accept/handshake/parse/queue/worker/switch) vào ring mỗi thread, xem GET /api/trace
+    bool traceEnabled = false;
+    int traceBufferEvents = 16384;  // số event giữ lại mỗi thread
+};
@@ -11,6 +11,10 @@ public:
     int acceptClient();
     void closeSocket();
 
+    // Chuyển listening socket sang non-blocking (dùng với epoll)
+    bool setNonBlocking();
+    int fd() const { return serverFd; }
+
 private:
     int serverFd;
 };
@@ -0,0 +1,58 @@
+#pragma once
+#include <sys/uio.h>
+
+#include <cstddef>
+
+#include "core/Response.hpp"
+
+struct Connection;
+
+// Forward declaration cho OpenSSL
+typedef struct ssl_st SSL;
+
+// Ghi dữ liệu qua SSL (hoặc socket thường khi tắt TLS) trên socket non-blocking
+// (chờ bằng poll khi WANT_* / EAGAIN)
+namespace SslIO {
+
+// Timeout gửi response (thay cho SO_SNDTIMEO cũ)
+constexpr int SEND_TIMEOUT_MS = 5000;
+
+// Payload tối đa của 1 TLS record: các đoạn nhỏ được gom tới cỡ này rồi mới SSL_write
+constexpr std::size_t TLS_RECORD_BYTES = 16 * 1024;
+
+// Chờ fd sẵn sàng (socket non-blocking), false nếu timeout/lỗi
+bool waitFd(int fd, short events, int timeoutMs);
+
+// Gửi toàn bộ buffer qua SSL, false nếu lỗi/timeout
+bool sendAll(SSL* ssl, const char* data, std::size_t len);
+
+// Gửi body nằm trong file:
+//  - kTLS đang bật cho chiều gửi -> SSL_sendfile (kernel mã hóa, không copy lên user-space)
+//  - ngược lại -> mmap từng cửa sổ + SSL_write thẳng từ vùng map
+// FileBody nhiều part (multipart/byteranges): xen kẽ header part và đoạn file
+bool sendFile(SSL* ssl, const FileBody& file);
+
+// Các hàm theo Connection: conn.ssl == nullptr -> socket thường
+bool send(Connection& conn, const char* data, std::size_t len);
+
+// Gửi nhiều đoạn như 1 khối liên tục:
+//  - plaintext: writev (xử lý ghi thiếu)
+//  - TLS: gom vào buffer của thread tới cỡ 1 record rồi SSL_write 1 lần,
+//    đoạn lớn còn lại gửi thẳng từ vùng nhớ gốc (không copy)
+bool sendv(Connection& conn, const iovec* iov, int count);
+
+// plaintext: sendfile(); TLS: như sendFile(SSL*, ...)
+bool sendFile(Connection& conn, const FileBody& file);
+
+// Gửi tới khi hết hoặc socket đầy, không bao giờ poll (dùng trên reactor).
+// sent = số byte đã gửi lần này. TLS: chưa xong thì lần sau phải gọi lại với đúng phần còn lại
+enum class TrySend { Done, WantWrite, WantRead, Error };
+TrySend trySend(Connection& conn, const char* data, std::size_t len, std::size_t& sent);
+
+// Status line + header + body (hoặc file) của response
+bool sendResponse(Connection& conn, const Response& res);
+
+// kTLS có đang offload chiều gửi của connection này không
+bool ktlsSendActive(SSL* ssl);
+
+}  // namespace SslIO
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Cache in-memory cho static asset (read-mostly).
+// Mỗi entry giữ sẵn status line + header đã serialize cùng body,
+// nên hit chỉ còn 1 lần ghi socket (không open/read/stat, không dò MIME).
+//  - Lookup chỉ lấy shared_lock; LRU xấp xỉ bằng tick atomic trên mỗi entry
+//  - Giới hạn tổng bộ nhớ, vượt cap -> bỏ entry lâu không dùng nhất
+//  - inotify theo dõi thư mục gốc (đệ quy), file đổi/xóa -> invalidate
+class StaticCache {
+public:
+    struct Asset {
+        // "HTTP/1.1 200 OK\r\nContent-Length: ..\r\nContent-Type: ..\r\n"
+        // (chưa có header Connection và dòng trống kết thúc)
+        std::string head;
+        std::string body;
+
+        std::size_t bytes() const { return head.size() + body.size(); }
+    };
+
+    struct Stats {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+        std::uint64_t invalidations;
+        std::size_t   entries;
+        std::size_t   bytes;
+        std::size_t   capacity;
+    };
+
+    // root: thư mục static (vd "www"), maxBytes: tổng cap, maxEntryBytes: file lớn hơn không cache
+    StaticCache(const std::string& root, std::size_t maxBytes, std::size_t maxEntryBytes);
+    ~StaticCache();
+
+    StaticCache(const StaticCache&) = delete;
+    StaticCache& operator=(const StaticCache&) = delete;
+
+    // Hit -> entry; miss -> đọc file (nếu là file thường và đủ nhỏ) rồi cache.
+    // nullptr nếu file không tồn tại hoặc quá lớn để cache.
+    std::shared_ptr<const Asset> get(const std::string& fullPath);
+
+    void invalidate(const std::string& fullPath);
+    void invalidatePrefix(const std::string& dirPath);
+
+    Stats stats() const;
+
+    // MIME type theo đuôi file
+    static const char* mimeType(const std::string& path);
+
+private:
+    struct Slot {
+        std::shared_ptr<const Asset> asset;
+        mutable std::atomic<std::uint64_t> lastUsed{0};
+    };
+
+    std::shared_ptr<const Asset> load(const std::string& fullPath);
+    void evictLocked(std::size_t incoming);
+
+    void watchLoop();
+    void addWatchRecursive(const std::string& dir);
+
+    std::string root;
+    std::size_t maxBytes;
+    std::size_t maxEntryBytes;
+
+    mutable std::shared_mutex mtx;
+    std::unordered_map<std::string, std::unique_ptr<Slot>> map;
+    std::size_t usedBytes = 0;
+
+    std::atomic<std::uint64_t> tick{0};
+    // Tăng mỗi lần invalidate: load() bắt đầu trước đó thì không được insert (tránh cache bản cũ)
+    std::atomic<std::uint64_t> generation{0};
+
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+    std::atomic<std::uint64_t> invalidations{0};
+
+    // inotify
+    int inotifyFd = -1;
+    int stopFd = -1;
+    std::unordered_map<int, std::string> watchDirs;  // wd -> thư mục (chỉ watch thread dùng)
+    std::thread watcher;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Body upload được ghi xuống file tạm cạnh file đích (cùng filesystem).
+// commit() rename atomic sang file đích; bị hủy mà chưa commit -> xóa file tạm.
+// Reader không bao giờ thấy file đích ghi dở.
+//
+// write(2) không chạy trên reactor: append() chỉ copy vào backlog trong RAM,
+// 1 IO thread dùng chung ghi xuống đĩa. Backlog mỗi upload giới hạn MAX_BACKLOG,
+// vượt thì reactor ngừng đọc connection đó (pauseUntilDrained) tới khi IO thread lấy đi ghi.
+// RAM mỗi upload tối đa ~2 * MAX_BACKLOG (1 phần đang ghi + 1 phần đang đọc tiếp).
+class UploadFile : public std::enable_shared_from_this<UploadFile> {
+public:
+    // Reactor ngừng đọc khi backlog chờ ghi vượt mức này
+    static constexpr std::size_t MAX_BACKLOG = 1 << 20;
+
+    ~UploadFile();
+
+    UploadFile(const UploadFile&) = delete;
+    UploadFile& operator=(const UploadFile&) = delete;
+
+    // Tạo file tạm "<dir>/.upload-XXXXXX" cho target (tạo thư mục nếu cần), nullptr nếu lỗi
+    static std::shared_ptr<UploadFile> create(const std::string& target);
+
+    // Đưa 1 đoạn body vào backlog cho IO thread (không chạm đĩa).
+    // false nếu lần ghi trước đã lỗi (disk full, ...)
+    bool append(const char* data, std::size_t len);
+
+    // Backlog > MAX_BACKLOG: giữ onDrained, IO thread gọi (1 lần) khi đã lấy backlog
+    // đi ghi hoặc ghi lỗi -> true, caller phải ngừng đọc.
+    // Chưa vượt -> false, onDrained không bao giờ được gọi
+    bool pauseUntilDrained(std::function<void()> onDrained);
+
+    // Chờ IO thread ghi hết backlog, đóng file tạm và rename sang target, false nếu lỗi.
+    // Chạy trên worker (có thể chờ đĩa)
+    bool commit();
+
+    const std::string& target() const { return targetPath; }
+
+private:
+    friend struct UploadIO;
+
+    UploadFile(int fd, std::string tempPath, std::string targetPath);
+
+    int fd = -1;
+    std::string tempPath;
+    std::string targetPath;
+    bool committed = false;
+
+    // Chia sẻ giữa reactor (append), IO thread và worker (commit)
+    std::mutex mtx;
+    std::condition_variable idleCv;  // IO thread xong việc với file này
+    std::string backlog;
+    bool queued = false;             // đang nằm trong hàng đợi / đang được IO thread ghi
+    bool failed = false;
+    std::function<void()> onDrained;
+};
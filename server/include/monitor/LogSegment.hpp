@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "monitor/Logger.hpp"
+
+// Log nhị phân: file segment = header 256 byte + mảng LogRecord 64 byte (little-endian).
+// Method/algo lưu dạng mã (giá trị enum), bảng tên nằm trong header để reader ngoài
+// (tools/log_export) không phụ thuộc enum của server.
+namespace LogSegment {
+
+constexpr char MAGIC[8] = {'H', 'L', 'O', 'G', 'S', 'E', 'G', '1'};
+constexpr std::uint32_t VERSION = 2;  // v2: thêm thời gian từng giai đoạn
+constexpr std::size_t DICT_SIZE = 8;
+constexpr std::size_t NAME_LEN = 8;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint8_t methodCount;
+    std::uint8_t algoCount;
+    std::uint8_t reserved0[6];
+    char methods[DICT_SIZE][NAME_LEN];  // không cần '\0' nếu dài đúng NAME_LEN
+    char algos[DICT_SIZE][NAME_LEN];
+    std::uint8_t reserved[256 - 152];
+};
+static_assert(sizeof(Header) == 256, "segment header layout");
+
+struct Record {
+    std::int64_t timestampNs;
+    float cpu;
+    std::uint32_t queueLen;
+    std::uint32_t pathLength;
+    std::int32_t estimatedWorkload;
+    std::uint32_t reqSize;
+    float responseMs;
+    float latencyAvg;
+    float queueMs;
+    float serviceMs;
+    float writeMs;
+    float handshakeMs;
+    float readMs;
+    std::uint8_t method;
+    std::uint8_t algoEnqueue;
+    std::uint8_t algoRun;
+    std::uint8_t reserved[5];
+};
+static_assert(sizeof(Record) == 64, "log record layout");
+
+// Header với bảng tên lấy từ enum HttpMethod / SchedAlgo
+Header makeHeader();
+Record toRecord(const LogEntry& e);
+
+// Tên file segment thứ seq: "<prefix>.000001.bin"
+std::string segmentPath(const std::string& prefix, std::uint32_t seq);
+
+// Các segment của prefix, theo thứ tự seq tăng dần
+std::vector<std::string> listSegments(const std::string& prefix);
+
+// CSV dùng chung cho Logger (dạng CSV), /api/logs và tools/log_export
+extern const char* const CSV_HEADER;
+struct StageMs {
+    double queue, service, write, handshake, read;
+};
+void appendCsvRow(std::string& out, std::int64_t timestampNs, double cpu, std::uint64_t queueLen,
+                  const char* method, std::uint64_t pathLength, std::int64_t estimatedWorkload,
+                  const char* algoEnqueue, const char* algoRun, std::uint64_t reqSize,
+                  double responseMs, double latencyAvg, const StageMs& stages);
+
+// Segment đã mmap (chỉ đọc). Record cuối ghi dở (file bị cắt) bị bỏ qua
+class Reader {
+public:
+    Reader() = default;
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // false + log nếu không mở / không map được hoặc sai magic/version (segment v1 cũ không đọc được)
+    bool open(const std::string& path);
+
+    std::size_t size() const { return count_; }
+    const Record* records() const { return records_; }
+
+    const char* methodName(std::uint8_t code) const;
+    const char* algoName(std::uint8_t code) const;
+
+    // Thêm 1 dòng CSV của record i vào out
+    void appendCsv(std::string& out, std::size_t i) const;
+
+private:
+    void close();
+
+    void* map_ = nullptr;
+    std::size_t mapLen_ = 0;
+    const Record* records_ = nullptr;
+    std::size_t count_ = 0;
+    char methods_[DICT_SIZE][NAME_LEN + 1] = {};
+    char algos_[DICT_SIZE][NAME_LEN + 1] = {};
+};
+
+}  // namespace LogSegment
@@ -1,36 +1,114 @@
 #pragma once
-#include <string>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scheduler/Task.hpp"
 
+// Bản ghi kích thước cố định (không cấp phát): worker chỉ copy vào ring của thread mình,
+// chuỗi (timestamp, method, algo) do thread writer format lúc ghi file.
 struct LogEntry {
-    std::string timestamp;
+    std::int64_t timestamp_ns;   // system_clock, ns từ epoch
 
     double cpu;
-    std::size_t queue_len;
+    std::uint64_t queue_len;
 
-    std::string request_method;
-    std::size_t request_path_length;
+    HttpMethod request_method;
+    std::uint32_t request_path_length;
     int estimated_workload;
 
-    std::string algo_at_enqueue;
-    std::string algo_at_run;
+    SchedAlgo algo_at_enqueue;
+    SchedAlgo algo_at_run;
 
-    std::size_t req_size;
-    double response_time_ms;
+    std::uint64_t req_size;
+    double response_time_ms;     // enqueue -> ghi xong
     double prev_latency_avg;
+
+    // Tách theo giai đoạn (xem RequestTimeline)
+    double queue_ms;
+    double service_ms;
+    double write_ms;
+    double handshake_ms;         // chỉ request đầu của connection, còn lại 0
+    double read_ms;
 };
 
+// Log bất đồng bộ: log() đẩy LogEntry vào ring SPSC riêng của thread gọi (lock-free),
+// thread writer mỗi flushInterval gom hết các ring, format 1 lần rồi write() cả khối.
+// Ring đầy -> bỏ bản ghi và tăng bộ đếm dropped (không bao giờ chặn request).
+//   Csv:    path là file CSV (append)
+//   Binary: path là prefix, ghi segment "<path>.NNNNNN.bin" (xem LogSegment.hpp),
+//           đủ segmentBytes thì sang segment mới
 class Logger {
 public:
-    Logger(const std::string& filePath);
+    enum class Format { Csv, Binary };
+
+    explicit Logger(const std::string& path,
+                    std::chrono::milliseconds flushInterval = std::chrono::milliseconds(200),
+                    Format format = Format::Csv,
+                    std::size_t segmentBytes = 64 * 1024 * 1024);
     ~Logger();
 
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Hot path: vài chục ns, không lock, không syscall
     void log(const LogEntry& e);
+
+    // Ghi ngay mọi bản ghi đang nằm trong ring (vd. trước khi đọc lại file)
     void flush();
 
+    struct Stats {
+        std::uint64_t written = 0;
+        std::uint64_t dropped = 0;
+        std::size_t rings = 0;
+    };
+    Stats stats() const;
+
+    // Số bản ghi mỗi ring (mỗi thread ghi log có 1 ring)
+    static constexpr std::size_t RING_CAPACITY = 4096;
+
 private:
-    std::ofstream file;
-    std::mutex mtx;
-    int counter = 0;
+    struct Ring;
+
+    Ring* ringForThisThread();
+    void run();
+    // Gom mọi ring ra file; gọi dưới drainMtx_ (chỉ 1 consumer mỗi lúc)
+    void drainLocked();
+
+    // Binary: đóng segment hiện tại, mở segment kế tiếp (ghi header)
+    bool openNextSegment();
+
+    // CSV: mở để append; file cũ có header khác CSV_HEADER (số cột cũ) thì đổi tên
+    // sang "<path>.<YYYYmmdd-HHMMSS>" và bắt đầu file mới, không trộn 2 schema
+    bool openCsv();
+
+    int fd = -1;
+    Format format;
+    std::string path;
+    std::size_t segmentBytes;
+    std::uint32_t segmentSeq = 0;
+    std::size_t segmentSize = 0;  // byte đã ghi vào segment hiện tại
+
+    std::chrono::milliseconds flushInterval;
+    std::uint64_t id;  // phân biệt Logger cho cache thread_local
+
+    // Danh sách ring: chỉ khoá khi thread mới đăng ký / writer duyệt
+    mutable std::mutex ringsMtx;
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    std::mutex drainMtx;
+    std::string buf;  // buffer format, dưới drainMtx
+    std::atomic<std::uint64_t> written{0};
+
+    std::atomic<bool> stop{false};
+    std::mutex stopMtx;
+    std::condition_variable stopCv;
+    std::thread writer;
 };
@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "scheduler/Task.hpp"
+
+// Histogram log-linear kiểu HDR trên micro giây: mỗi lũy thừa 2 chia 8 bucket
+// (sai số tương đối <= 12.5%), giá trị < 8us có bucket riêng.
+struct LatencyBuckets {
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int MAX_MSB = 31;  // ~35 phút, lớn hơn dồn vào bucket cuối
+    static constexpr std::size_t COUNT = SUB + (MAX_MSB - SUB_BITS + 1) * SUB;
+
+    static std::size_t index(std::uint64_t us) {
+        if (us < (std::uint64_t)SUB) return (std::size_t)us;
+        int msb = 63 - __builtin_clzll(us);
+        if (msb > MAX_MSB) return COUNT - 1;
+        std::size_t sub = (std::size_t)(us >> (msb - SUB_BITS)) & (SUB - 1);
+        return (std::size_t)(msb - SUB_BITS + 1) * SUB + sub;
+    }
+
+    // Bucket đầu tiên bắt đầu từ 2^k us (biên lũy thừa 2 trùng biên bucket)
+    static std::size_t firstIndexOfPow2(int k) {
+        return k < SUB_BITS ? ((std::size_t)1 << k) : (std::size_t)(k - SUB_BITS + 1) * SUB;
+    }
+};
+
+// Metrics HTTP cho /metrics (format Prometheus text).
+// Mỗi thread ghi vào shard riêng (1 writer -> load+store relaxed, không lock, không RMW);
+// scrape cộng dồn mọi shard, chỉ khoá danh sách shard.
+class Metrics {
+public:
+    enum class Route : std::uint8_t { Static, FileApi, Logs, Stats, Metrics, Api, Other, COUNT };
+    static constexpr std::size_t ROUTES = (std::size_t)Route::COUNT;
+    static constexpr std::size_t ALGOS = (std::size_t)SchedAlgo::ADAPTIVE + 1;
+    static constexpr int MAX_STATUS = 600;
+
+    static Route classify(std::string_view method, std::string_view path);
+    static const char* routeName(Route r);
+
+    struct Sample {
+        Route route;
+        SchedAlgo algo;
+        int status;
+        std::uint64_t bytesIn;
+        std::uint64_t bytesOut;
+        std::uint64_t queueWaitUs;   // enqueue -> worker bắt đầu
+        std::uint64_t serviceUs;     // worker bắt đầu -> response dựng xong
+        std::uint64_t writeUs;       // ghi response ra socket
+        std::uint64_t readUs;        // byte đầu -> parse xong
+        std::uint64_t handshakeUs;   // accept -> TLS xong (chỉ tính khi firstOnConnection)
+        bool firstOnConnection;
+    };
+
+    // Hot path (thread worker)
+    void record(const Sample& s);
+
+    // Text exposition 0.0.4 (chỉ series khác 0)
+    std::string render() const;
+
+private:
+    using Counter = std::atomic<std::uint64_t>;
+
+    struct Histogram {
+        std::array<Counter, LatencyBuckets::COUNT> buckets{};
+        Counter sumUs{0};
+    };
+
+    struct Shard {
+        Counter requests[ROUTES][ALGOS] = {};
+        Counter status[MAX_STATUS] = {};
+        Counter bytesIn{0};
+        Counter bytesOut{0};
+        Histogram queueWait[ALGOS];
+        Histogram service[ROUTES][ALGOS];
+        Histogram write[ROUTES];
+        Histogram read;
+        Histogram handshake;
+    };
+
+    Shard* shardForThisThread();
+
+    std::uint64_t id = nextId();
+    static std::uint64_t nextId();
+
+    mutable std::mutex shardsMtx;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
@@ -1,24 +1,33 @@
 #pragma once
-#include <atomic>
-#include <mutex>
+#include <chrono>
+#include <cstdint>
 
 class SystemMetrics {
 public:
-    // Gọi 1 lần lúc khởi động (main.cpp)
-    static void init();
+    // Chạy thread lấy mẫu (main.cpp), mỗi period tính lại CPU tổng hợp
+    static void init(std::chrono::milliseconds period = std::chrono::milliseconds(200));
 
-    // CPU tổng hợp: kết hợp giữa CPU OS (/proc/stat) và busy-time đo được
-    static double getCpuUsage();
+    // Dừng + join thread lấy mẫu (gọi lại init() được)
+    static void stop();
 
-    // Gọi từ SmartLoad để cộng thêm thời gian CPU bận (tính bằng giây)
-    static void addBusy(double seconds);
+    // CPU tổng hợp: kết hợp CPU OS (cgroup v2 nếu chạy trong container, không thì /proc/stat)
+    // và busy-time worker đo được, tính trên phần CPU thực sự được cấp
+    static double getCpuUsage();
 
-private:
-    // CPU (%) đã tính sẵn, cache lại để đọc nhanh
-    static std::atomic<double> CPU_CACHE;
+    // CPU time của thread gọi (CLOCK_THREAD_CPUTIME_ID), ns
+    static std::uint64_t threadCpuNs();
 
-    // Tổng busy-time (giây) tích lũy trong 1 window (200ms)
-    static std::atomic<double> BUSY_ACCUM;
+    // Cộng CPU time bận vào bộ đếm riêng của thread gọi (không lock, không RMW)
+    static void addBusyNs(std::uint64_t ns);
 
-    static std::mutex busyMutex;
+    // Lần lấy mẫu gần nhất (cho /api/stats)
+    struct Snapshot {
+        double cpu = 0.0;          // = getCpuUsage()
+        double osCpu = 0.0;
+        double busyPercent = 0.0;
+        double cpuLimit = 0.0;     // số core được cấp (quota cgroup / affinity)
+        bool cgroup = false;       // osCpu lấy từ cgroup v2 cpu.stat
+        std::uint64_t periodMs = 0;
+    };
+    static Snapshot snapshot();
 };
@@ -0,0 +1,123 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Trace span theo Chrome trace-event (mở bằng chrome://tracing hoặc ui.perfetto.dev).
+// Mỗi thread ghi vào ring riêng (ghi đè bản cũ nhất, kiểu flight recorder); dumpJson()
+// đọc mọi ring qua seqlock từng slot, không chặn thread đang ghi.
+// Tắt: mỗi điểm trace chỉ tốn 1 load relaxed (enabled()).
+//
+// Mọi chuỗi (cat, name, tên arg, arg chuỗi) phải sống suốt chương trình
+// (literal, schedAlgoName, ...): ring chỉ lưu con trỏ.
+struct TraceArg {
+    const char* name = nullptr;
+    std::int64_t num = 0;
+    const char* str = nullptr;  // != nullptr -> xuất chuỗi thay vì num
+
+    TraceArg() = default;
+    TraceArg(const char* n, std::int64_t v) : name(n), num(v) {}
+    TraceArg(const char* n, const char* s) : name(n), str(s) {}
+};
+
+struct TraceEvent {
+    const char* cat;
+    const char* name;
+    std::uint64_t tsNs;   // steady_clock
+    std::uint64_t durNs;
+    std::uint64_t id;     // async span: id nối 2 đầu
+    TraceArg args[3];
+    std::uint64_t phase;  // 'X' complete, 'i' instant, 'A' async (xuất thành cặp b/e)
+};
+
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    static Tracer& instance();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // eventsPerThread làm tròn lên lũy thừa 2; chỉ áp dụng cho ring tạo sau lần enable đầu
+    void enable(std::size_t eventsPerThread);
+    void disable();
+
+    // Tên hiển thị của thread gọi (metadata thread_name), gọi đầu hàm chạy của thread
+    static void setThreadName(const char* name);
+
+    // Span đã đo xong trên thread gọi
+    static void complete(const char* cat, const char* name, TimePoint start, TimePoint end,
+                         TraceArg a0 = {}, TraceArg a1 = {}, TraceArg a2 = {}) {
+        if (enabled()) instance().record('X', cat, name, start, end, 0, a0, a1, a2);
+    }
+
+    static void instant(const char* cat, const char* name, TraceArg a0 = {}, TraceArg a1 = {}) {
+        if (enabled()) {
+            auto now = Clock::now();
+            instance().record('i', cat, name, now, now, 0, a0, a1, {});
+        }
+    }
+
+    // Span không gắn thread (vd. request nằm chờ trong queue), nhóm theo id
+    static void async(const char* cat, const char* name, std::uint64_t id, TimePoint start,
+                      TimePoint end, TraceArg a0 = {}, TraceArg a1 = {}) {
+        if (enabled()) instance().record('A', cat, name, start, end, id, a0, a1, {});
+    }
+
+    // JSON {"traceEvents": [...]} của mọi event còn trong ring
+    std::string dumpJson() const;
+
+    struct Stats {
+        bool enabled = false;
+        std::uint64_t recorded = 0;
+        std::uint64_t overwritten = 0;  // bị ghi đè trước khi dump
+        std::size_t threads = 0;
+        std::size_t eventsPerThread = 0;
+    };
+    Stats stats() const;
+
+private:
+    struct Ring;
+
+    Tracer() = default;
+    Ring* ringForThisThread();
+    void record(char phase, const char* cat, const char* name, TimePoint start, TimePoint end,
+                std::uint64_t id, const TraceArg& a0, const TraceArg& a1, const TraceArg& a2);
+
+    static std::atomic<bool> enabled_;
+
+    std::atomic<std::size_t> capacity_{0};
+
+    mutable std::mutex ringsMtx_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+// Đo span theo scope: không bật trace -> không gọi clock
+class TraceScope {
+public:
+    TraceScope(const char* cat, const char* name) : cat_(cat), name_(name), on_(Tracer::enabled()) {
+        if (on_) start_ = Tracer::Clock::now();
+    }
+    ~TraceScope() {
+        if (on_) Tracer::complete(cat_, name_, start_, Tracer::Clock::now(), args_[0], args_[1], args_[2]);
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    void arg(std::size_t i, TraceArg a) {
+        if (on_ && i < 3) args_[i] = a;
+    }
+
+private:
+    const char* cat_;
+    const char* name_;
+    bool on_;
+    Tracer::TimePoint start_;
+    TraceArg args_[3];
+};
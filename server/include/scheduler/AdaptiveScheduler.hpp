@@ -1,42 +1,65 @@
 #pragma once
 
-#include "scheduler/Scheduler.hpp"
-#include "ai/AIClient.hpp"
+#include "scheduler/LockedScheduler.hpp"
+#include "scheduler/MultiPolicyQueue.hpp"
+#include "ai/AIPredictor.hpp"
+#include "ai/TreeModel.hpp"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
-class AdaptiveScheduler : public Scheduler {
+class AdaptiveScheduler : public LockedScheduler {
 public:
     AdaptiveScheduler();
 
-    // Tên thuật toán hiện tại
-    std::string currentAlgorithm() const override;
+    // Thuật toán hiện tại (đọc không cần lock)
+    SchedAlgo currentAlgorithm() const override;
 
-    // enqueue
-    void enqueue(const Task& task) override;
-    void enqueue(const Task& task, std::size_t queueLen) override;
-
-    // dequeue
-    Task dequeue() override;
-
-    bool empty() const override;
+    // enqueue: quyết định thuật toán rồi đẩy vào queue chung
+    void enqueue(Task&& task) override;
+    void enqueue(Task&& task, std::size_t queueLen) override;
 
     // (Không dùng trong adaptive mới, nhưng giữ để tránh lỗi interface)
     void setTimeSlice(int ts) override {}
     void updateWeights(int newWeight) override {}
 
+    // Chi phí đổi thuật toán (export ra /api/stats). Bản thân switch chỉ là đổi algo_,
+    // chi phí thật nằm ở MultiPolicyQueue: bỏ qua entry stale + build lại index
+    struct SwitchStats {
+        std::uint64_t switches = 0;
+        std::uint64_t stalePops = 0;              // entry stale bị bỏ qua khi pop (tổng)
+        std::uint64_t stalePopsSinceSwitch = 0;   // ... kể từ lần switch gần nhất
+        std::uint64_t compactions = 0;            // số lần build lại index (lazy delete)
+        std::uint64_t compactionNs = 0;
+        std::uint64_t compactionNsSinceSwitch = 0;
+        std::size_t pending = 0;
+    };
+    SwitchStats switchStats() const;
+
+    // Model nhúng (có thể chưa load) + predictor AI server (nullptr nếu đã có model nhúng)
+    const TreeModel* model() const { return model_.get(); }
+    const AIPredictor* predictor() const { return predictor_.get(); }
+
+protected:
+    void pushLocked(Task&& task) override { queue_.push(std::move(task)); }
+    Task popLocked() override { return queue_.pop(algo_.load(std::memory_order_relaxed)); }
+    bool emptyLocked() const override { return queue_.empty(); }
+
 private:
     // -------------------------------
-    //   Scheduler bên trong (FIFO/SJF/RR/WFQ)
+    //   Task chờ: 1 kho chung, index riêng cho FIFO/SJF/RR/WFQ
+    //   -> đổi thuật toán chỉ đổi algo_, không chuyển task (O(1))
     // -------------------------------
-    std::unique_ptr<Scheduler> inner_;
-    std::string algoName_;
-
-    // Mutex bảo vệ state
-    mutable std::mutex mtx_;
+    MultiPolicyQueue queue_;
+    std::atomic<SchedAlgo> algo_{SchedAlgo::FIFO};
+    // Dưới mtx_: số lần switch + mốc stale pops / compaction ns lúc switch gần nhất
+    std::uint64_t switches_ = 0;
+    std::uint64_t stalePopsAtSwitch_ = 0;
+    std::uint64_t compactionNsAtSwitch_ = 0;
 
     // -------------------------------
     //   Adaptive workload tracking
@@ -48,13 +71,9 @@ private:
     double workloadVariability();
 
     // Thuật toán quyết định thuật toán lập lịch
-    std::string decideAlgorithm(double cpu, std::size_t queueLen, double wvar);
-
-    // Factory tạo scheduler
-    std::unique_ptr<Scheduler> make(const std::string& name);
+    SchedAlgo decideAlgorithm(double cpu, std::size_t queueLen, double wvar);
 
     bool aiEnabled_ = true;
-    std::unique_ptr<AIClient> ai_;
-    std::chrono::steady_clock::time_point lastAiCall_{};
-    std::chrono::milliseconds aiMinInterval_{200};
+    std::shared_ptr<const TreeModel> model_;
+    std::shared_ptr<AIPredictor> predictor_;
 };
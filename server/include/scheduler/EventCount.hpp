@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Eventcount trên futex: consumer park khi queue rỗng mà không cần mutex/cv.
+//   key = prepareWait(); kiểm tra lại queue; còn rỗng -> wait(key), có hàng -> cancelWait(key)
+// notify chỉ tốn 1 load khi không ai đang chờ (đường nóng của producer không syscall).
+// notify "nhận" luôn 1 waiter (trừ bộ đếm cùng lúc tăng epoch): notify liên tiếp trước khi
+// waiter kịp chạy không gọi futex_wake lặp lại.
+class EventCount {
+public:
+    using Key = std::uint32_t;
+
+    Key prepareWait() {
+        std::uint64_t prev = state.fetch_add(ONE_WAITER, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return static_cast<Key>(prev >> 32);
+    }
+
+    // Không chờ nữa (đã thấy dữ liệu). Epoch đã đổi -> 1 notify đã trừ phần của mình
+    void cancelWait(Key key) {
+        std::uint64_t cur = state.load(std::memory_order_relaxed);
+        while (static_cast<Key>(cur >> 32) == key) {
+            if (state.compare_exchange_weak(cur, cur - ONE_WAITER, std::memory_order_relaxed)) return;
+        }
+    }
+
+    // Ngủ tới khi có notify sau prepareWait() (trả về ngay nếu đã có)
+    void wait(Key key);
+
+    // Như wait() nhưng tối đa timeout; false nếu hết giờ (đã tự bỏ đăng ký chờ)
+    bool waitFor(Key key, std::chrono::nanoseconds timeout);
+
+    void notifyOne() { notify(false); }
+    void notifyAll() { notify(true); }
+
+private:
+    void notify(bool all);
+
+    // Nửa 32 bit chứa epoch, là word mà futex chờ trên đó
+    std::uint32_t* epochWord();
+
+    static constexpr std::uint64_t ONE_WAITER = 1;
+    static constexpr std::uint64_t ONE_EPOCH = std::uint64_t(1) << 32;
+
+    // [epoch:32 | số waiter chưa được notify:32]
+    std::atomic<std::uint64_t> state{0};
+};
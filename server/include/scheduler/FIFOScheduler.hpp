@@ -1,48 +1,120 @@
 #pragma once
 
 #include "Scheduler.hpp"
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#include "EventCount.hpp"
+#include "MpmcRing.hpp"
+#include <atomic>
+#include <thread>
 
+// FIFO trên ring lock-free: enqueue/dequeue không lấy mutex nào,
+// worker rảnh park trên futex (EventCount) thay vì condition_variable.
 class FIFOScheduler : public Scheduler {
 public:
-    FIFOScheduler() = default;
+    static constexpr std::size_t DEFAULT_CAPACITY = 16384;
 
-    std::string currentAlgorithm() const override {
-        return "FIFO";
+    explicit FIFOScheduler(std::size_t capacity = DEFAULT_CAPACITY) : ring_(capacity) {}
+
+    SchedAlgo currentAlgorithm() const override {
+        return SchedAlgo::FIFO;
+    }
+
+    // Task tới sau luôn đứng sau cả lô
+    bool batchOrderSafe() const override {
+        return true;
+    }
+
+    void enqueue(Task&& task) override {
+        enqueue(std::move(task), 0);
     }
 
-    void enqueue(const Task& task) override {
-        enqueue(task, 0);
+    bool tryEnqueue(Task& task, std::size_t /*queueLen*/) override {
+        if (closed_.load() || !ring_.tryPush(task)) return false;
+        notEmpty_.notifyOne();
+        return true;
     }
 
-    void enqueue(const Task& task, std::size_t /*queueLen*/) override {
-        {
-            std::lock_guard<std::mutex> lock(mtx_);
-            queue_.push(task);
+    void enqueue(Task&& task, std::size_t /*queueLen*/) override {
+        // Ring đầy: chờ tới khi worker lấy bớt. Reactor không đi đường này (dùng tryEnqueue)
+        while (!ring_.tryPush(task)) {
+            EventCount::Key key = notFull_.prepareWait();
+            if (ring_.tryPush(task)) {
+                notFull_.cancelWait(key);
+                break;
+            }
+            if (closed_.load()) {
+                // Không còn worker lấy nữa: bỏ task (hủy Task -> đóng connection)
+                notFull_.cancelWait(key);
+                return;
+            }
+            notFull_.wait(key);
         }
-        cv_.notify_one();
+        notEmpty_.notifyOne();
     }
 
     Task dequeue() override {
-        std::unique_lock<std::mutex> lock(mtx_);
-        cv_.wait(lock, [this]() {
-            return !queue_.empty();
-        });
-
-        Task t = queue_.front();
-        queue_.pop();
+        Task t;
+        while (!dequeueFor(t, std::chrono::hours(1))) {
+            if (closed_.load()) break;
+        }
         return t;
     }
 
+    bool tryDequeue(Task& out) override {
+        if (!ring_.tryPop(out)) return false;
+        notFull_.notifyOne();
+        return true;
+    }
+
+    bool dequeueFor(Task& out, std::chrono::milliseconds timeout) override {
+        // Spin ngắn trước khi park: task thường tới ngay sau khi worker vừa xong việc
+        for (int i = 0; i < SPIN_TRIES; ++i) {
+            if (tryDequeue(out)) return true;
+            std::this_thread::yield();
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            EventCount::Key key = notEmpty_.prepareWait();
+            if (tryDequeue(out)) {
+                notEmpty_.cancelWait(key);
+                return true;
+            }
+            if (closed_.load()) {
+                notEmpty_.cancelWait(key);
+                return false;
+            }
+            if (!notEmpty_.waitFor(key, deadline - std::chrono::steady_clock::now())) {
+                return tryDequeue(out);
+            }
+        }
+    }
+
+    std::size_t dequeueBatch(Task* out, std::size_t maxTasks,
+                             std::chrono::milliseconds timeout) override {
+        if (maxTasks == 0) return 0;
+        std::size_t n = 0;
+        if (!dequeueFor(out[n], timeout)) return 0;
+        ++n;
+        // Ring không có lock để khấu hao: batch chỉ gom các pop liền nhau
+        while (n < maxTasks && tryDequeue(out[n])) ++n;
+        return n;
+    }
+
+    void close() override {
+        closed_.store(true);
+        notEmpty_.notifyAll();
+        notFull_.notifyAll();
+    }
+
     bool empty() const override {
-        std::lock_guard<std::mutex> lock(mtx_);
-        return queue_.empty();
+        return ring_.sizeApprox() == 0;
     }
 
 private:
-    mutable std::mutex mtx_;
-    std::condition_variable cv_;
-    std::queue<Task> queue_;
+    static constexpr int SPIN_TRIES = 4;
+
+    MpmcRing<Task> ring_;
+    EventCount notEmpty_;
+    EventCount notFull_;
+    std::atomic<bool> closed_{false};
 };
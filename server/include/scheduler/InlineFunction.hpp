@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Callable void() move-only, closure nằm ngay trong object (không cấp phát heap).
+// Closure lớn hơn Capacity -> lỗi biên dịch thay vì lặng lẽ new như std::function.
+template <std::size_t Capacity>
+class InlineFunction {
+public:
+    InlineFunction() noexcept = default;
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction>>>
+    InlineFunction(F&& f) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Capacity, "closure too large for InlineFunction");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "closure over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "closure must be nothrow-movable");
+
+        ::new (static_cast<void*>(storage)) Fn(std::forward<F>(f));
+        ops = &opsFor<Fn>;
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept { moveFrom(other); }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    explicit operator bool() const noexcept { return ops != nullptr; }
+
+    void operator()() { ops->invoke(storage); }
+
+    void reset() noexcept {
+        if (ops) {
+            ops->destroy(storage);
+            ops = nullptr;
+        }
+    }
+
+private:
+    // "vtable" tự dựng: 1 con trỏ cho mỗi kiểu closure
+    struct Ops {
+        void (*invoke)(void*);
+        void (*move)(void* dst, void* src);  // move-construct dst từ src rồi hủy src
+        void (*destroy)(void*);
+    };
+
+    template <typename Fn>
+    static void invokeImpl(void* p) { (*static_cast<Fn*>(p))(); }
+
+    template <typename Fn>
+    static void moveImpl(void* dst, void* src) {
+        Fn* s = static_cast<Fn*>(src);
+        ::new (dst) Fn(std::move(*s));
+        s->~Fn();
+    }
+
+    template <typename Fn>
+    static void destroyImpl(void* p) { static_cast<Fn*>(p)->~Fn(); }
+
+    template <typename Fn>
+    static constexpr Ops opsFor{&invokeImpl<Fn>, &moveImpl<Fn>, &destroyImpl<Fn>};
+
+    void moveFrom(InlineFunction& other) noexcept {
+        if (!other.ops) return;
+        other.ops->move(storage, other.storage);
+        ops = other.ops;
+        other.ops = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char storage[Capacity];
+    const Ops* ops = nullptr;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Scheduler.hpp"
+#include <condition_variable>
+#include <mutex>
+
+// Khung chung cho scheduler dùng mutex + condition_variable (SJF/RR/WFQ):
+// lớp con chỉ cài cấu trúc queue (push/pop/empty, luôn gọi khi đang giữ mtx_),
+// các biến thể dequeue / batch / close nằm ở đây.
+class LockedScheduler : public Scheduler {
+public:
+    using Scheduler::enqueue;
+
+    void enqueue(Task&& task) override {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            pushLocked(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    Task dequeue() override {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return closed_ || !emptyLocked(); });
+        if (emptyLocked()) return Task{};
+        return popLocked();
+    }
+
+    bool tryDequeue(Task& out) override {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (emptyLocked()) return false;
+        out = popLocked();
+        return true;
+    }
+
+    bool dequeueFor(Task& out, std::chrono::milliseconds timeout) override {
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (!cv_.wait_for(lock, timeout, [this] { return closed_ || !emptyLocked(); })) return false;
+        if (emptyLocked()) return false;
+        out = popLocked();
+        return true;
+    }
+
+    std::size_t dequeueBatch(Task* out, std::size_t maxTasks,
+                             std::chrono::milliseconds timeout) override {
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (!cv_.wait_for(lock, timeout, [this] { return closed_ || !emptyLocked(); })) return 0;
+
+        std::size_t n = 0;
+        while (n < maxTasks && !emptyLocked()) out[n++] = popLocked();
+        return n;
+    }
+
+    void close() override {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool empty() const override {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return emptyLocked();
+    }
+
+protected:
+    virtual void pushLocked(Task&& task) = 0;
+    virtual Task popLocked() = 0;
+    virtual bool emptyLocked() const = 0;
+
+    mutable std::mutex mtx_;
+
+private:
+    std::condition_variable cv_;
+    bool closed_ = false;
+};
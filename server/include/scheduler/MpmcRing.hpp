@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Ring buffer bounded, lock-free, nhiều producer / nhiều consumer (thuật toán Vyukov).
+// Mỗi ô có sequence riêng: producer/consumer chỉ tranh nhau 1 CAS trên vị trí head/tail,
+// dữ liệu được move vào/ra ô mà không cần lock.
+template <typename T>
+class MpmcRing {
+public:
+    // capacity làm tròn lên lũy thừa của 2
+    explicit MpmcRing(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask = cap - 1;
+        cells = std::make_unique<Cell[]>(cap);
+        for (std::size_t i = 0; i < cap; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpmcRing() {
+        T tmp;
+        while (tryPop(tmp)) {}
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    // Ring đầy -> false, v giữ nguyên (chỉ bị move khi thành công)
+    bool tryPush(T& v) {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* c;
+        while (true) {
+            c = &cells[pos & mask];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // đầy
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(c->storage)) T(std::move(v));
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Ring rỗng -> false
+    bool tryPop(T& out) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* c;
+        while (true) {
+            c = &cells[pos & mask];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // rỗng
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T* item = std::launder(reinterpret_cast<T*>(c->storage));
+        out = std::move(*item);
+        item->~T();
+        c->seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Ước lượng (có thể cũ ngay khi trả về)
+    std::size_t sizeApprox() const {
+        std::size_t e = enqueuePos.load(std::memory_order_relaxed);
+        std::size_t d = dequeuePos.load(std::memory_order_relaxed);
+        return e > d ? e - d : 0;
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // head/tail ở 2 cache line riêng, tránh false sharing giữa producer và consumer
+    alignas(64) std::atomic<std::size_t> enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos{0};
+    alignas(64) std::size_t mask = 0;
+    std::unique_ptr<Cell[]> cells;
+};
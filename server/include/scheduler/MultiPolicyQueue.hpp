@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Task.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+// Kho task chờ dùng chung cho cả 4 policy: mỗi task nằm 1 chỗ (slot), còn mỗi policy
+// có index riêng trỏ vào slot (FIFO/RR: hàng đợi, SJF/WFQ: heap).
+// pop(policy) lấy theo index của policy đó; entry của task ở các index khác thành "stale"
+// (slot đã đổi generation) và bị bỏ qua khi gặp, index quá nhiều rác thì build lại.
+// -> đổi policy chỉ là đổi tham số của pop(), không phải chuyển task.
+// Không thread-safe: người dùng giữ lock.
+class MultiPolicyQueue {
+public:
+    explicit MultiPolicyQueue(int rrTimeSlice = 5) : rrTimeSlice_(rrTimeSlice) {}
+
+    void push(Task&& task);
+
+    // Rỗng -> Task rỗng (fn == nullptr)
+    Task pop(SchedAlgo policy);
+
+    std::size_t size() const { return live_; }
+    bool empty() const { return live_ == 0; }
+
+    // Tổng số lần build lại index và thời gian đã tốn (ns)
+    std::uint64_t compactions() const { return compactions_; }
+    std::uint64_t compactionNs() const { return compactionNs_; }
+    // Tổng số entry stale bị bỏ qua khi pop
+    std::uint64_t stalePops() const { return stalePops_; }
+
+private:
+    struct Ref {
+        std::uint32_t slot;
+        std::uint32_t gen;
+    };
+    struct KeyedRef {
+        double key;
+        std::uint64_t seq;  // cùng key -> vào trước ra trước
+        Ref ref;
+    };
+    struct Later {
+        bool operator()(const KeyedRef& a, const KeyedRef& b) const {
+            return a.key != b.key ? a.key > b.key : a.seq > b.seq;
+        }
+    };
+
+    bool alive(Ref r) const { return gen_[r.slot] == r.gen; }
+    Task release(Ref r);
+
+    Ref popFifo();
+    Ref popRr();
+    Ref popHeap(std::vector<KeyedRef>& heap);
+
+    // Index nào có quá nhiều entry stale -> lọc và dựng lại (khấu hao O(1) mỗi pop)
+    void maybeCompact();
+
+    std::vector<Task> tasks_;
+    std::vector<std::uint32_t> gen_;  // tăng mỗi khi slot được giải phóng
+    std::vector<std::uint32_t> free_;
+    std::size_t live_ = 0;
+    std::uint64_t seq_ = 0;
+
+    std::deque<Ref> fifo_;
+    std::deque<Ref> rr_;
+    std::vector<KeyedRef> sjf_;
+    std::vector<KeyedRef> wfq_;
+
+    int rrTimeSlice_;
+
+    // WFQ: virtual time + finish time từng flow (nhóm theo weight)
+    double virtualTime_ = 0.0;
+    std::unordered_map<int, double> lastFinishTime_;
+
+    std::uint64_t compactions_ = 0;
+    std::uint64_t compactionNs_ = 0;
+    std::uint64_t stalePops_ = 0;
+};
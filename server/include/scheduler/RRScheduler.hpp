@@ -1,59 +1,53 @@
 #pragma once
 
-#include "Scheduler.hpp"
+#include "LockedScheduler.hpp"
 #include <queue>
-#include <mutex>
-#include <condition_variable>
 
-class RRScheduler : public Scheduler {
+class RRScheduler : public LockedScheduler {
 public:
     explicit RRScheduler(int timeSlice = 5)
         : timeSlice_(timeSlice) {}
 
-    std::string currentAlgorithm() const override {
-        return "RR";
+    SchedAlgo currentAlgorithm() const override {
+        return SchedAlgo::RR;
     }
 
     void setTimeSlice(int ts) override {
         timeSlice_ = ts;
     }
 
-    void enqueue(const Task& task) override {
-        std::lock_guard<std::mutex> lock(mtx_);
-        queue_.push(task);
-        cv_.notify_one();
+protected:
+    void pushLocked(Task&& task) override {
+        queue_.push(std::move(task));
     }
 
-    Task dequeue() override {
-        std::unique_lock<std::mutex> lock(mtx_);
-        cv_.wait(lock, [this] {
-            return !queue_.empty();
-        });
-
-        Task t = queue_.front();
-        queue_.pop();
-
+    Task popLocked() override {
         // ============================
         // ROUND ROBIN CORE LOGIC
         // ============================
-        if (t.remainingTime > timeSlice_) {
-            t.remainingTime -= timeSlice_;
-            queue_.push(t);               // push back as unfinished
-        } else {
-            t.remainingTime = 0;          // finished
+        // Worker không preempt được task, nên quantum được mô phỏng trên queue:
+        // task còn dài hơn 1 time slice bị trừ slice và xoay xuống cuối,
+        // task đầu tiên vừa trong slice được trả ra (mỗi task chạy đúng 1 lần)
+        while (true) {
+            Task t = std::move(queue_.front());
+            queue_.pop();
+
+            if (t.remainingTime > timeSlice_) {
+                t.remainingTime -= timeSlice_;
+                queue_.push(std::move(t));   // push back as unfinished
+                continue;
+            }
+
+            t.remainingTime = 0;             // finished
+            return t;
         }
-
-        return t;
     }
 
-    bool empty() const override {
-        std::lock_guard<std::mutex> lock(mtx_);
+    bool emptyLocked() const override {
         return queue_.empty();
     }
 
 private:
     int timeSlice_;
     std::queue<Task> queue_;
-    mutable std::mutex mtx_;
-    std::condition_variable cv_;
 };
@@ -1,45 +1,33 @@
 #pragma once
 
-#include "Scheduler.hpp"
-#include <queue>
+#include "LockedScheduler.hpp"
+#include <algorithm>
 #include <vector>
-#include <mutex>
-#include <condition_variable>
 
-class SJFScheduler : public Scheduler {
+class SJFScheduler : public LockedScheduler {
 public:
-    SJFScheduler() = default;
+    SJFScheduler() { heap_.reserve(1024); }
 
-    std::string currentAlgorithm() const override {
-        return "SJF";
+    SchedAlgo currentAlgorithm() const override {
+        return SchedAlgo::SJF;
     }
 
-    void enqueue(const Task& task) override {
-        enqueue(task, 0);
+protected:
+    void pushLocked(Task&& task) override {
+        heap_.push_back(std::move(task));
+        std::push_heap(heap_.begin(), heap_.end(), Compare{});
     }
 
-    void enqueue(const Task& task, std::size_t /*queueLen*/) override {
-        {
-            std::lock_guard<std::mutex> lock(mtx_);
-            pq_.push(task);
-        }
-        cv_.notify_one();
-    }
-
-    Task dequeue() override {
-        std::unique_lock<std::mutex> lock(mtx_);
-        cv_.wait(lock, [this]() {
-            return !pq_.empty();
-        });
-
-        Task t = pq_.top();
-        pq_.pop();
+    Task popLocked() override {
+        // pop_heap đưa task ưu tiên nhất ra cuối rồi move ra (priority_queue::top() chỉ cho const&)
+        std::pop_heap(heap_.begin(), heap_.end(), Compare{});
+        Task t = std::move(heap_.back());
+        heap_.pop_back();
         return t;
     }
 
-    bool empty() const override {
-        std::lock_guard<std::mutex> lock(mtx_);
-        return pq_.empty();
+    bool emptyLocked() const override {
+        return heap_.empty();
     }
 
 private:
@@ -50,7 +38,5 @@ private:
         }
     };
 
-    mutable std::mutex mtx_;
-    std::condition_variable cv_;
-    std::priority_queue<Task, std::vector<Task>, Compare> pq_;
+    std::vector<Task> heap_;  // min-heap theo estimatedTime
 };
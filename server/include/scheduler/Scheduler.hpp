@@ -1,25 +1,52 @@
 #pragma once
 
 #include "Task.hpp"
-#include <string>
+#include <chrono>
 #include <cstddef>
 
 class Scheduler {
 public:
     virtual ~Scheduler() = default;
 
-    // Thêm task mới vào queue
-    virtual void enqueue(const Task& task) = 0;
+    // Thêm task mới vào queue (task move-only, scheduler giữ luôn)
+    virtual void enqueue(Task&& task) = 0;
 
     // Overload có queueLen (dùng cho Adaptive); mặc định bỏ qua
-    virtual void enqueue(const Task& task, std::size_t queueLen) {
+    virtual void enqueue(Task&& task, std::size_t queueLen) {
         (void)queueLen;
-        enqueue(task);
+        enqueue(std::move(task));
     }
 
-    // Lấy task tiếp theo theo chính sách lập lịch
+    // Không chờ: false nếu queue đầy, task vẫn nằm nguyên ở caller (reactor trả 503).
+    // Mặc định queue không giới hạn -> luôn nhận
+    virtual bool tryEnqueue(Task& task, std::size_t queueLen) {
+        enqueue(std::move(task), queueLen);
+        return true;
+    }
+
+    // Lấy task tiếp theo theo chính sách lập lịch, chờ nếu rỗng.
+    // Đã close() và hết task -> trả Task rỗng (fn == nullptr)
     virtual Task dequeue() = 0;
 
+    // Không chờ: false nếu rỗng
+    virtual bool tryDequeue(Task& out) = 0;
+
+    // Chờ tối đa timeout: false nếu hết giờ, hoặc đã close() và rỗng
+    virtual bool dequeueFor(Task& out, std::chrono::milliseconds timeout) = 0;
+
+    // Lấy tối đa maxTasks task theo đúng thứ tự lập lịch trong 1 lần lock;
+    // rỗng thì chờ như dequeueFor. Trả về số task đã ghi vào out
+    virtual std::size_t dequeueBatch(Task* out, std::size_t maxTasks,
+                                     std::chrono::milliseconds timeout) = 0;
+
+    // true: lấy 1 lô rồi chạy tuần tự vẫn giữ đúng thứ tự lập lịch (task tới sau không bao giờ
+    // được chạy trước task đã có) -> worker được dùng dequeueBatch. SJF/RR/WFQ: false
+    virtual bool batchOrderSafe() const { return false; }
+
+    // Đánh thức mọi thread đang chờ; từ đó dequeue* không chờ nữa
+    // (task còn lại vẫn lấy ra được)
+    virtual void close() = 0;
+
     // Cho biết scheduler còn task hay không
     virtual bool empty() const = 0;
 
@@ -29,6 +56,6 @@ public:
     // Optional: cho WFQ (nếu cần)
     virtual void updateWeights(int /*newWeight*/) {}
 
-    // Tên thuật toán hiện tại (FIFO/SJF/RR/WFQ/ADAPTIVE...)
-    virtual std::string currentAlgorithm() const = 0;
+    // Thuật toán hiện tại (FIFO/SJF/RR/WFQ; Adaptive trả thuật toán bên trong)
+    virtual SchedAlgo currentAlgorithm() const = 0;
 };
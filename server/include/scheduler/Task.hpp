@@ -1,42 +1,93 @@
 // Task.hpp
 #pragma once
-#include <functional>
-#include <string>
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 
-struct Task {
-    std::size_t id{};
+#include "scheduler/InlineFunction.hpp"
+
+// Method/thuật toán lưu dạng enum 1 byte thay cho std::string trong Task
+enum class HttpMethod : std::uint8_t { GET, POST, PUT, DELETE, HEAD, OTHER };
+enum class SchedAlgo : std::uint8_t { FIFO, SJF, RR, WFQ, ADAPTIVE };
+
+inline HttpMethod parseHttpMethod(std::string_view m) {
+    if (m == "GET") return HttpMethod::GET;
+    if (m == "POST") return HttpMethod::POST;
+    if (m == "PUT") return HttpMethod::PUT;
+    if (m == "DELETE") return HttpMethod::DELETE;
+    if (m == "HEAD") return HttpMethod::HEAD;
+    return HttpMethod::OTHER;
+}
+
+inline const char* httpMethodName(HttpMethod m) {
+    switch (m) {
+    case HttpMethod::GET:    return "GET";
+    case HttpMethod::POST:   return "POST";
+    case HttpMethod::PUT:    return "PUT";
+    case HttpMethod::DELETE: return "DELETE";
+    case HttpMethod::HEAD:   return "HEAD";
+    default:                 return "OTHER";
+    }
+}
+
+inline const char* schedAlgoName(SchedAlgo a) {
+    switch (a) {
+    case SchedAlgo::FIFO:     return "FIFO";
+    case SchedAlgo::SJF:      return "SJF";
+    case SchedAlgo::RR:       return "RR";
+    case SchedAlgo::WFQ:      return "WFQ";
+    case SchedAlgo::ADAPTIVE: return "ADAPTIVE";
+    }
+    return "FIFO";
+}
+
+// "SJF", "RR", ... (vd kết quả AI); false nếu không nhận ra
+inline bool parseSchedAlgo(std::string_view s, SchedAlgo& out) {
+    if (s == "FIFO") out = SchedAlgo::FIFO;
+    else if (s == "SJF") out = SchedAlgo::SJF;
+    else if (s == "RR") out = SchedAlgo::RR;
+    else if (s == "WFQ") out = SchedAlgo::WFQ;
+    else return false;
+    return true;
+}
+
+// Closure của task chỉ nên giữ vài con trỏ (request nằm trên heap, task giữ con trỏ tới nó)
+using TaskFn = InlineFunction<24>;
+
+// Move-only, đúng 1 cache line: queue của scheduler chỉ di chuyển 64 byte, không cấp phát
+struct alignas(64) Task {
+    std::uint32_t id{};
     int estimatedTime{};
-    int remainingTime{}; 
-    int weight{};
-    std::string algoAtEnqueue;
+    int remainingTime{};
+    std::uint32_t request_path_length{};
+    std::uint32_t req_size{};
+    std::uint8_t weight{};
+    HttpMethod request_method{HttpMethod::OTHER};
+    SchedAlgo algoAtEnqueue{SchedAlgo::FIFO};
 
-    std::string request_method;
-    int request_path_length{};
-    std::size_t req_size{};
+    // Finish tag (thời gian ảo) của WFQ, scheduler khác bỏ qua
+    double finishTag{};
 
-    std::function<void()> fn;
+    TaskFn fn;
 
     Task() = default;
 
-    Task(
-        std::size_t id_,
-        int est_,
-        int weight_,
-        std::string algo_,
-        std::string method_,
-        int pathLen_,
-        std::size_t reqSize_,
-        std::function<void()> fn_
-    )
+    Task(std::uint32_t id_, int est_, int weight_, SchedAlgo algo_, HttpMethod method_,
+         std::uint32_t pathLen_, std::uint32_t reqSize_, TaskFn fn_)
         : id(id_),
           estimatedTime(est_),
           remainingTime(est_),
-          weight(weight_),
-          algoAtEnqueue(std::move(algo_)),
-          request_method(std::move(method_)),
           request_path_length(pathLen_),
           req_size(reqSize_),
+          weight(static_cast<std::uint8_t>(weight_)),
+          request_method(method_),
+          algoAtEnqueue(algo_),
           fn(std::move(fn_)) {}
+
+    Task(Task&&) noexcept = default;
+    Task& operator=(Task&&) noexcept = default;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
 };
 
+static_assert(sizeof(Task) == 64, "Task must stay one cache line");
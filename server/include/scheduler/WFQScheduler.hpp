@@ -1,71 +1,60 @@
 #pragma once
 
-#include "Scheduler.hpp"
-#include <queue>
+#include "LockedScheduler.hpp"
+#include <algorithm>
 #include <vector>
-#include <mutex>
-#include <condition_variable>
 #include <unordered_map>
 
-class WFQScheduler : public Scheduler {
+class WFQScheduler : public LockedScheduler {
 public:
-    WFQScheduler() : virtualTime_(0.0) {}
+    WFQScheduler() : virtualTime_(0.0) { heap_.reserve(1024); }
 
-    std::string currentAlgorithm() const override {
-        return "WFQ";
+    SchedAlgo currentAlgorithm() const override {
+        return SchedAlgo::WFQ;
     }
 
-    void enqueue(const Task& task) override {
-        std::lock_guard<std::mutex> lock(mtx_);
-
+protected:
+    void pushLocked(Task&& task) override {
         double nowV = virtualTime_;
 
         double lastFinish = lastFinishTime_[task.weight]; // nhóm theo weight (flow)
         double S = std::max(lastFinish, nowV);
-        double F = S + (double)task.estimatedTime / std::max(1, task.weight);
+        double F = S + (double)task.estimatedTime / std::max(1, (int)task.weight);
 
         // Lưu lại finish time flow
         lastFinishTime_[task.weight] = F;
 
-        // đẩy vào PQ
-        pq_.push(WFQItem{task, S, F});
-        cv_.notify_one();
+        // finish tag nằm ngay trong Task (vẫn 1 cache line), đẩy vào heap
+        task.finishTag = F;
+        heap_.push_back(std::move(task));
+        std::push_heap(heap_.begin(), heap_.end(), Later{});
     }
 
-    Task dequeue() override {
-        std::unique_lock<std::mutex> lock(mtx_);
-
-        cv_.wait(lock, [this] { return !pq_.empty(); });
-
-        WFQItem item = pq_.top();
-        pq_.pop();
+    Task popLocked() override {
+        std::pop_heap(heap_.begin(), heap_.end(), Later{});
+        Task t = std::move(heap_.back());
+        heap_.pop_back();
 
         // tăng virtual time
-        virtualTime_ = item.finishTime;
+        virtualTime_ = t.finishTag;
 
-        return item.task;
+        return t;
     }
 
-    bool empty() const override {
-        std::lock_guard<std::mutex> lock(mtx_);
-        return pq_.empty();
+    bool emptyLocked() const override {
+        return heap_.empty();
     }
 
 private:
-    struct WFQItem {
-        Task task;
-        double startTime;
-        double finishTime;
-
-        bool operator<(WFQItem const& other) const {
-            return finishTime > other.finishTime; 
+    // Finish tag nhỏ nhất ra trước
+    struct Later {
+        bool operator()(const Task& a, const Task& b) const {
+            return a.finishTag > b.finishTag;
         }
     };
 
     double virtualTime_;
     std::unordered_map<int, double> lastFinishTime_;
 
-    std::priority_queue<WFQItem> pq_;
-    mutable std::mutex mtx_;
-    std::condition_variable cv_;
+    std::vector<Task> heap_;
 };
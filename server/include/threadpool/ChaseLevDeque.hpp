@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Deque work-stealing Chase-Lev (bản C11 của Lê et al. 2013), dung lượng cố định.
+// Chủ sở hữu push/pop ở đáy (LIFO, không CAS trừ khi tranh phần tử cuối),
+// thread khác steal ở đỉnh (FIFO, 1 CAS). T phải copy được nguyên tử (con trỏ, chỉ số).
+template <typename T>
+class ChaseLevDeque {
+public:
+    // capacity làm tròn lên lũy thừa của 2
+    explicit ChaseLevDeque(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask = (std::int64_t)cap - 1;
+        buffer = std::make_unique<std::atomic<T>[]>(cap);
+    }
+
+    // Chỉ chủ sở hữu. Đầy -> false
+    bool push(T x) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        if (b - t > mask) return false;
+
+        buffer[b & mask].store(x, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Chỉ chủ sở hữu. Rỗng -> false
+    bool pop(T& out) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = buffer[b & mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Phần tử cuối: tranh với thief bằng CAS trên top
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Thread bất kỳ. Rỗng hoặc thua CAS -> false
+    bool steal(T& out) {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+
+        T x = buffer[t & mask].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return false;
+        }
+        out = x;
+        return true;
+    }
+
+    // Ước lượng (có thể cũ ngay khi trả về)
+    std::size_t sizeApprox() const {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? (std::size_t)(b - t) : 0;
+    }
+
+private:
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    alignas(64) std::int64_t mask = 0;
+    std::unique_ptr<std::atomic<T>[]> buffer;
+};
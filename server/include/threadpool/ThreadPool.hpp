@@ -4,27 +4,47 @@
 #include <vector>
 #include <thread>
 #include <atomic>
-#include <functional>
-#include <mutex>
-#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <string>
 
+#include "scheduler/EventCount.hpp"
 #include "scheduler/Task.hpp"
 #include "scheduler/Scheduler.hpp"
 
 class ThreadPool {
 public:
-    // ThreadPool không còn queue riêng, chỉ kéo Task từ Scheduler
+    // Shared: mọi worker kéo Task từ 1 scheduler chung
     ThreadPool(int threads, Scheduler* scheduler);
+
+    // Work-stealing: mỗi worker có scheduler riêng theo policy `algo` (thứ tự trong worker)
+    // + deque Chase-Lev; task vào inbox của worker theo round-robin, worker rảnh đi steal
+    ThreadPool(int threads, const std::string& algo);
+
     ~ThreadPool();
 
     // optional, để debug
     std::size_t getWorkerCount() const { return workers.size(); }
 
-    // Không cần enqueue nữa – scheduler chịu trách nhiệm queue
-    // Để không phá code cũ, bạn có thể để method rỗng:
-    void enqueue(const Task& /*task*/) {
-        // no-op: tất cả task phải được đưa vào scheduler, không phải ThreadPool
-    }
+    // Đưa task vào pool: shared -> scheduler chung, work-stealing -> inbox 1 worker.
+    // Không bao giờ chờ: false nếu queue / mọi inbox đều đầy (task vẫn ở caller)
+    bool trySubmit(Task& task, std::size_t queueLen);
+
+    // Thuật toán đang áp dụng: shared -> scheduler chung,
+    // work-stealing -> policy của worker đang gọi (ngoài worker: worker 0)
+    SchedAlgo currentAlgorithm() const;
+
+    bool workStealing() const { return !locals.empty(); }
+
+    struct StealStats {
+        std::size_t workers = 0;
+        std::uint64_t executed = 0;  // tổng task đã chạy
+        std::uint64_t stolen = 0;    // trong đó lấy từ worker khác
+    };
+    StealStats stealStats() const;
+
+    // Các scheduler pool đang dùng (shared: 1, work-stealing: 1 mỗi worker) – cho /api/stats
+    std::vector<const Scheduler*> schedulers() const;
 
     std::size_t getPendingTaskCount() const {
         return pendingTasks.load(std::memory_order_relaxed);
@@ -39,20 +59,32 @@ public:
         pendingTasks.fetch_sub(1, std::memory_order_relaxed);
     }
 
-    void notifyWorker() {
-        cv.notify_one();
-    }
-
 private:
+    struct Worker;
+
+    // Batch tối đa mỗi lần dequeue (shared mode, chỉ scheduler batchOrderSafe)
+    // và thời gian chờ trước khi kiểm tra stop lại
+    static constexpr std::size_t MAX_BATCH = 8;
+    static constexpr std::chrono::milliseconds IDLE_WAIT{100};
+
     void workerLoop();
+    void stealingLoop(std::size_t self);
 
-    Scheduler* scheduler;
+    // Các bước của stealingLoop
+    bool refill(Worker& w);
+    bool trySteal(std::size_t self, Task& out);
+    bool hasWork() const;
+    void runTask(Task& t);
+
+    Scheduler* scheduler = nullptr;
     std::vector<std::thread> workers;
     std::atomic<bool> stop{false};
 
+    // Work-stealing: state riêng từng worker + chỗ park chung
+    std::vector<std::unique_ptr<Worker>> locals;
+    std::atomic<std::size_t> nextWorker{0};
+    EventCount idle;
+
     // Đếm task đang "trong hệ thống" (đang chờ + đang chạy)
     std::atomic<std::size_t> pendingTasks{0};
-
-    std::condition_variable cv;
-    std::mutex queueMutex;
 };
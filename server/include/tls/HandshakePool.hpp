@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/Connection.hpp"
+
+class Reactor;
+
+// Pool thread riêng cho SSL handshake (tách khỏi ThreadPool xử lý request).
+// Mỗi worker có epoll riêng, chạy SSL_accept non-blocking theo
+// SSL_ERROR_WANT_READ/WANT_WRITE. Handshake xong -> trả connection về reactor
+// sở hữu nó để đọc request. Burst crypto không chặn accept hay làm đói worker.
+class HandshakePool {
+public:
+    struct Stats {
+        std::size_t   threads;
+        std::size_t   queueDepth;      // handshake đang chờ/chạy
+        std::size_t   peakQueueDepth;
+        std::uint64_t completed;
+        std::uint64_t failed;          // lỗi SSL/socket, không tính timedOut
+        std::uint64_t timedOut;
+        double        avgMs;           // từ lúc accept tới lúc handshake xong
+        double        maxMs;
+    };
+
+    HandshakePool(int threads, int timeoutSec);
+    ~HandshakePool();
+
+    HandshakePool(const HandshakePool&) = delete;
+    HandshakePool& operator=(const HandshakePool&) = delete;
+
+    // Gọi từ reactor ngay sau accept (thread-safe)
+    void submit(std::shared_ptr<Connection> conn, Reactor* owner);
+
+    void stop();
+
+    Stats stats() const;
+
+private:
+    struct Pending {
+        std::shared_ptr<Connection> conn;
+        Reactor* owner = nullptr;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    struct Worker {
+        int epollFd = -1;
+        int wakeFd  = -1;
+        std::thread thread;
+
+        std::mutex mtx;
+        std::vector<Pending> incoming;               // chờ worker nhận
+        std::unordered_map<int, Pending> active;     // fd -> handshake đang chạy
+    };
+
+    void run(Worker& w);
+    void adopt(Worker& w);
+    // false = xong (thành công hoặc lỗi), đã gỡ khỏi worker
+    bool drive(Worker& w, Pending& p);
+    // Kết quả handshake, mỗi handshake chỉ được đếm vào 1 counter
+    enum class Outcome { Done, Failed, TimedOut };
+    void finish(Worker& w, int fd, Outcome outcome);
+    void sweep(Worker& w);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> nextWorker{0};
+    std::atomic<bool> running{true};
+    int timeoutSec;
+
+    std::atomic<std::size_t>   depth{0};
+    std::atomic<std::size_t>   peakDepth{0};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::uint64_t> timedOut{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declaration cho OpenSSL
+typedef struct ssl_st SSL;
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_session_st SSL_SESSION;
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+typedef struct evp_mac_ctx_st EVP_MAC_CTX;
+
+// Session resumption phía server:
+//  - cache session-ID in-memory chia shard (mỗi shard 1 mutex + LRU riêng)
+//  - session ticket mã hóa bằng key tự sinh, xoay vòng định kỳ
+// Client quay lại bỏ qua được phần crypto bất đối xứng của full handshake.
+class TlsSessionCache {
+public:
+    struct Stats {
+        std::uint64_t cacheHits;
+        std::uint64_t cacheMisses;
+        std::uint64_t cacheStored;
+        std::uint64_t cacheEvicted;
+        std::uint64_t ticketIssued;
+        std::uint64_t ticketHits;     // ticket giải mã được (key hiện tại hoặc cũ)
+        std::uint64_t ticketMisses;   // key không còn / ticket lạ -> full handshake
+        std::uint64_t keyRotations;
+        std::size_t   sessions;
+    };
+
+    // maxSessions: tổng số session giữ trong cache (chia đều cho các shard)
+    // ticketRotateSec: chu kỳ xoay key ticket (0 = tắt session ticket)
+    TlsSessionCache(std::size_t maxSessions, int ticketRotateSec);
+    ~TlsSessionCache();
+
+    TlsSessionCache(const TlsSessionCache&) = delete;
+    TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+    // Cài callback cache + ticket vào SSL_CTX (gọi 1 lần, trước khi accept)
+    void attach(SSL_CTX* ctx, long sessionTimeoutSec);
+
+    Stats stats() const;
+
+private:
+    static constexpr std::size_t SHARDS = 16;
+
+    struct Entry {
+        std::string der;                             // SSL_SESSION đã i2d
+        std::chrono::steady_clock::time_point expires;
+        std::list<std::string>::iterator lruIt;
+    };
+
+    struct Shard {
+        mutable std::mutex mtx;
+        std::unordered_map<std::string, Entry> map;
+        std::list<std::string> lru;  // front = mới dùng nhất
+    };
+
+    struct TicketKey {
+        std::array<unsigned char, 16> name;
+        std::array<unsigned char, 32> aesKey;
+        std::array<unsigned char, 32> hmacKey;
+        std::chrono::steady_clock::time_point created;
+    };
+
+    // OpenSSL callbacks (tìm lại instance qua SSL_CTX ex_data)
+    static TlsSessionCache* fromSsl(SSL* ssl);
+    static int onNewSession(SSL* ssl, SSL_SESSION* sess);
+    static SSL_SESSION* onGetSession(SSL* ssl, const unsigned char* id, int len, int* copy);
+    static int onTicketKey(SSL* ssl, unsigned char* keyName, unsigned char* iv,
+                           EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int enc);
+
+    Shard& shardFor(const std::string& id);
+    void store(const std::string& id, std::string der, long timeoutSec);
+    bool lookup(const std::string& id, std::string& der);
+
+    bool makeKey(TicketKey& key);
+    void rotateIfNeeded();
+    int ticketCallback(unsigned char* keyName, unsigned char* iv, EVP_CIPHER_CTX* cipher,
+                       EVP_MAC_CTX* mac, int enc);
+
+    std::size_t perShardCap;
+    std::array<Shard, SHARDS> shards;
+
+    // keys[0] = key hiện tại (mã hóa), các key sau chỉ dùng để giải mã ticket cũ
+    int ticketRotateSec;
+    mutable std::shared_mutex keyMtx;
+    std::vector<TicketKey> keys;
+
+    std::atomic<std::uint64_t> cacheHits{0};
+    std::atomic<std::uint64_t> cacheMisses{0};
+    std::atomic<std::uint64_t> cacheStored{0};
+    std::atomic<std::uint64_t> cacheEvicted{0};
+    std::atomic<std::uint64_t> ticketIssued{0};
+    std::atomic<std::uint64_t> ticketHits{0};
+    std::atomic<std::uint64_t> ticketMisses{0};
+    std::atomic<std::uint64_t> keyRotations{0};
+};
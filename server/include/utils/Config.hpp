@@ -11,6 +11,49 @@ public:
     std::string ai_url;
     std::string mode;
 
+    // Reactor sharding (SO_REUSEPORT)
+    int  acceptors;
+    bool pin_acceptors;
+    bool shard_scheduler;
+    bool work_stealing;
+
+    // HTTP keep-alive
+    int keepalive_timeout;
+    int keepalive_max_requests;
+
+    // TLS session resumption
+    int tls_session_cache_size;
+    int tls_session_timeout;
+    int tls_ticket_rotate;
+
+    // SSL handshake pool (0 = handshake trên reactor)
+    int handshake_threads;
+
+    // Zero-copy static file
+    bool tls;
+    bool ktls;
+    int  zero_copy_min_bytes;
+
+    // Static asset cache (byte, 0 = tắt)
+    int static_cache_bytes;
+    int static_cache_max_entry;
+
+    // Body giữ trong RAM / upload streaming xuống đĩa (byte)
+    long long max_body_bytes;
+    long long max_upload_bytes;
+
+    // Logger bất đồng bộ: chu kỳ ghi file (ms), "csv" | "binary", size 1 segment nhị phân
+    int log_flush_ms;
+    std::string log_format;
+    long long log_segment_bytes;
+
+    // Chu kỳ lấy mẫu CPU của SystemMetrics (ms)
+    int cpu_sample_ms;
+
+    // Tracing (Chrome trace-event qua /api/trace): bật/tắt, số event giữ lại mỗi thread
+    bool trace_enabled;
+    int trace_buffer_events;
+
     Config(const std::string& path) {
         try {
             std::ifstream file(path);
@@ -26,6 +69,40 @@ public:
             ai_url  = j.value("ai_url", "http://127.0.0.1:5000/predict");
             mode    = j.value("mode", "prod");   // ⭐ DEFAULT = prod
 
+            acceptors       = j.value("acceptors", 1);
+            pin_acceptors   = j.value("pin_acceptors", false);
+            shard_scheduler = j.value("shard_scheduler", false);
+            work_stealing   = j.value("work_stealing", false);
+            if (acceptors < 1) acceptors = 1;
+
+            keepalive_timeout      = j.value("keepalive_timeout", 5);
+            keepalive_max_requests = j.value("keepalive_max_requests", 100);
+
+            tls_session_cache_size = j.value("tls_session_cache_size", 20480);
+            tls_session_timeout    = j.value("tls_session_timeout", 300);
+            tls_ticket_rotate      = j.value("tls_ticket_rotate", 3600);
+
+            handshake_threads = j.value("handshake_threads", 2);
+
+            tls                 = j.value("tls", true);
+            ktls                = j.value("ktls", true);
+            zero_copy_min_bytes = j.value("zero_copy_min_bytes", 64 * 1024);
+
+            static_cache_bytes     = j.value("static_cache_bytes", 32 * 1024 * 1024);
+            static_cache_max_entry = j.value("static_cache_max_entry", 1024 * 1024);
+
+            max_body_bytes   = j.value("max_body_bytes", 5LL * 1024 * 1024);
+            max_upload_bytes = j.value("max_upload_bytes", 1024LL * 1024 * 1024);
+
+            log_flush_ms = j.value("log_flush_ms", 200);
+            if (log_flush_ms < 1) log_flush_ms = 1;
+            log_format        = j.value("log_format", "csv");
+            log_segment_bytes = j.value("log_segment_bytes", 64LL * 1024 * 1024);
+            cpu_sample_ms = j.value("cpu_sample_ms", 200);
+            if (cpu_sample_ms < 10) cpu_sample_ms = 10;
+            trace_enabled       = j.value("trace_enabled", false);
+            trace_buffer_events = j.value("trace_buffer_events", 16384);
+
             // Normalize (đưa về lowercase)
             for (auto& c : mode) c = std::tolower(c);
 
@@ -38,6 +115,7 @@ public:
             std::cout << "[Config] Loaded: port=" << port 
                       << ", threads=" << threads
                       << ", mode=" << mode 
+                      << ", acceptors=" << acceptors
                       << "\n";
 
         } catch (const std::exception& e) {
@@ -48,6 +126,29 @@ public:
             threads = 4;
             ai_url = "http://127.0.0.1:5000/predict";
             mode = "prod";
+            acceptors = 1;
+            pin_acceptors = false;
+            shard_scheduler = false;
+            work_stealing = false;
+            keepalive_timeout = 5;
+            keepalive_max_requests = 100;
+            tls_session_cache_size = 20480;
+            tls_session_timeout = 300;
+            tls_ticket_rotate = 3600;
+            handshake_threads = 2;
+            tls = true;
+            ktls = true;
+            zero_copy_min_bytes = 64 * 1024;
+            static_cache_bytes = 32 * 1024 * 1024;
+            static_cache_max_entry = 1024 * 1024;
+            max_body_bytes = 5LL * 1024 * 1024;
+            max_upload_bytes = 1024LL * 1024 * 1024;
+            log_flush_ms = 200;
+            log_format = "csv";
+            log_segment_bytes = 64LL * 1024 * 1024;
+            cpu_sample_ms = 200;
+            trace_enabled = false;
+            trace_buffer_events = 16384;
         }
     }
 };
@@ -12,23 +12,47 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* use
 }
 
 AIClient::AIClient(std::string url, long timeoutMs)
-    : url_(std::move(url)), timeoutMs_(timeoutMs) {}
-
-
-std::optional<std::string> AIClient::predict(const AIFeatures& f) const {
+    : url_(std::move(url)), timeoutMs_(timeoutMs) {
     CURL* curl = curl_easy_init();
-    if (!curl) return std::nullopt;
+    if (!curl) {
+        std::cerr << "[AI-CLIENT] curl_easy_init failed" << std::endl;
+        return;
+    }
 
-    std::string response;
     struct curl_slist* headers = nullptr;
     headers = curl_slist_append(headers, "Content-Type: application/json");
     headers = curl_slist_append(headers, "Host: 127.0.0.1");
 
+    // Option cố định set 1 lần; handle giữ connection cache -> các lần sau không connect lại
+    curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeoutMs_);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, timeoutMs_);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_);
+
+    curl_ = curl;
+    headers_ = headers;
+}
+
+AIClient::~AIClient() {
+    if (curl_) curl_easy_cleanup(static_cast<CURL*>(curl_));
+    if (headers_) curl_slist_free_all(static_cast<curl_slist*>(headers_));
+}
+
+
+std::optional<std::string> AIClient::predict(const AIFeatures& f) {
+    CURL* curl = static_cast<CURL*>(curl_);
+    if (!curl) return std::nullopt;
+
     json payload = {
         {"cpu", f.cpu},
         {"queue_len", f.queue_len},
         {"queue_bin", f.queue_bin},
-        {"request_method", f.request_method},
+        {"request_method", f.request_method ? f.request_method : "OTHER"},
         {"request_path_length", f.request_path_length},
         {"estimated_workload", f.estimated_workload},
         {"req_size", f.req_size}
@@ -37,22 +61,14 @@ std::optional<std::string> AIClient::predict(const AIFeatures& f) const {
     std::string body = payload.dump();
     std::cout << "[AI-CLIENT] POST " << url_ << " body=" << body << std::endl;
 
-    curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    response_.clear();
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)body.size());
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeoutMs_);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, timeoutMs_);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
 
     CURLcode res = curl_easy_perform(curl);
     long httpCode = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-
     if (res != CURLE_OK || httpCode < 200 || httpCode >= 300) {
         std::cerr << "[AI-CLIENT] request failed "
                   << "curl=" << curl_easy_strerror(res)
@@ -61,9 +77,9 @@ std::optional<std::string> AIClient::predict(const AIFeatures& f) const {
     }
 
     try {
-        auto j = json::parse(response);
+        auto j = json::parse(response_);
         if (!j.contains("algorithm")) {
-            std::cerr << "[AI-CLIENT] invalid response: " << response << std::endl;
+            std::cerr << "[AI-CLIENT] invalid response: " << response_ << std::endl;
             return std::nullopt;
         }
 
@@ -73,7 +89,7 @@ std::optional<std::string> AIClient::predict(const AIFeatures& f) const {
 
     } catch (const std::exception& e) {
         std::cerr << "[AI-CLIENT] json parse error: " << e.what()
-                  << " body=" << response << std::endl;
+                  << " body=" << response_ << std::endl;
         return std::nullopt;
     }
 }
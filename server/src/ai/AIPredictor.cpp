@@ -0,0 +1,147 @@
+#include "ai/AIPredictor.hpp"
+#include "monitor/Tracer.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<AIFeatures>::value,
+              "AIFeatures must be trivially copyable for the seqlock mailbox");
+
+static constexpr const char* AI_URL_DEFAULT = "http://127.0.0.1:5000/predict";
+static constexpr long AI_TIMEOUT_MS = 200;
+static constexpr std::chrono::milliseconds AI_MIN_INTERVAL{200};
+
+static std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+AIPredictor::AIPredictor(std::string url, long timeoutMs, std::chrono::milliseconds minInterval)
+    : client_(std::move(url), timeoutMs), minInterval_(minInterval) {
+    thread_ = std::thread([this] { run(); });
+}
+
+AIPredictor::~AIPredictor() {
+    {
+        std::lock_guard<std::mutex> lock(stopMtx_);
+        stop_.store(true, std::memory_order_release);
+    }
+    stopCv_.notify_all();
+    posted_.notifyAll();
+    if (thread_.joinable()) thread_.join();
+}
+
+std::shared_ptr<AIPredictor> AIPredictor::shared() {
+    static std::mutex m;
+    static std::weak_ptr<AIPredictor> instance;
+
+    std::lock_guard<std::mutex> lock(m);
+    auto p = instance.lock();
+    if (!p) {
+        p = std::make_shared<AIPredictor>(AI_URL_DEFAULT, AI_TIMEOUT_MS, AI_MIN_INTERVAL);
+        instance = p;
+    }
+    return p;
+}
+
+void AIPredictor::post(const AIFeatures& f) {
+    postCount_.fetch_add(1, std::memory_order_relaxed);
+
+    std::uint64_t s = seq_.load(std::memory_order_relaxed);
+    if ((s & 1) || !seq_.compare_exchange_strong(s, s + 1, std::memory_order_acquire)) {
+        dropCount_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::uint64_t buf[WORDS] = {};
+    std::memcpy(buf, &f, sizeof(f));
+    for (std::size_t i = 0; i < WORDS; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+
+    seq_.store(s + 2, std::memory_order_release);
+    posted_.notifyOne();
+}
+
+std::uint64_t AIPredictor::readMailbox(AIFeatures& out) const {
+    std::uint64_t buf[WORDS];
+    while (true) {
+        std::uint64_t s1 = seq_.load(std::memory_order_acquire);
+        if (s1 & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t i = 0; i < WORDS; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == s1) {
+            std::memcpy(&out, buf, sizeof(out));
+            return s1;
+        }
+    }
+}
+
+bool AIPredictor::recommendation(SchedAlgo& out) const {
+    int algo = recommended_.load(std::memory_order_acquire);
+    if (algo < 0) return false;
+
+    auto age = nowNs() - publishedAtNs_.load(std::memory_order_relaxed);
+    if (age > std::chrono::duration_cast<std::chrono::nanoseconds>(STALE_AFTER).count()) return false;
+
+    out = static_cast<SchedAlgo>(algo);
+    return true;
+}
+
+AIPredictor::Stats AIPredictor::stats() const {
+    Stats s;
+    s.posted = postCount_.load(std::memory_order_relaxed);
+    s.dropped = dropCount_.load(std::memory_order_relaxed);
+    s.predictions = predictCount_.load(std::memory_order_relaxed);
+    s.failures = failCount_.load(std::memory_order_relaxed);
+    s.lastLatencyUs = lastLatencyUs_.load(std::memory_order_relaxed);
+    s.recommended = recommended_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AIPredictor::run() {
+    Tracer::setThreadName("ai-predictor");
+    std::uint64_t seen = 0;
+
+    while (!stop_.load(std::memory_order_acquire)) {
+        // Chờ snapshot mới (seq chẵn khác lần trước)
+        auto key = posted_.prepareWait();
+        if (stop_.load(std::memory_order_acquire) || seq_.load(std::memory_order_acquire) != seen) {
+            posted_.cancelWait(key);
+        } else {
+            posted_.wait(key);
+            continue;
+        }
+        if (stop_.load(std::memory_order_acquire)) break;
+
+        AIFeatures f;
+        std::uint64_t s = readMailbox(f);
+        if (s == seen) continue;
+        seen = s;
+
+        auto t0 = std::chrono::steady_clock::now();
+        auto pred = client_.predict(f);
+        auto t1 = std::chrono::steady_clock::now();
+        Tracer::complete("ai", "ai_server_predict", t0, t1, {"ok", pred ? 1 : 0});
+        lastLatencyUs_.store(
+            (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count(),
+            std::memory_order_relaxed);
+
+        SchedAlgo algo;
+        if (pred && parseSchedAlgo(*pred, algo)) {  // "SJF", "RR", "WFQ", ...
+            publishedAtNs_.store(nowNs(), std::memory_order_relaxed);
+            recommended_.store(static_cast<int>(algo), std::memory_order_release);
+            predictCount_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            failCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Giãn nhịp gọi model; snapshot post trong lúc này chỉ đè nhau trong mailbox
+        std::unique_lock<std::mutex> lock(stopMtx_);
+        stopCv_.wait_until(lock, t0 + minInterval_,
+                           [this] { return stop_.load(std::memory_order_relaxed); });
+    }
+}
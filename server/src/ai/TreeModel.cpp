@@ -0,0 +1,214 @@
+#include "ai/TreeModel.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+static constexpr const char* MODEL_PATH_DEFAULT = "ai/models/scheduler_tree.json";
+static constexpr std::size_t MAX_FEATURES = 256;
+static constexpr std::size_t MAX_GROUPS = 16;
+
+static const char* const INPUT_NAMES[] = {
+    "cpu", "queue_len", "queue_bin", "request_method",
+    "request_path_length", "estimated_workload", "req_size",
+};
+
+bool TreeModel::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "[TREE-MODEL] cannot open " << path << std::endl;
+        return false;
+    }
+
+    try {
+        json j;
+        in >> j;
+        if (j.value("format", "") != "flat-trees-v1") {
+            std::cerr << "[TREE-MODEL] unknown format in " << path << std::endl;
+            return false;
+        }
+
+        std::vector<Feature> features;
+        for (const auto& jf : j.at("features")) {
+            std::string name = jf.at("input").get<std::string>();
+            Feature f{};
+            int idx = -1;
+            for (int i = 0; i < INPUT_COUNT; ++i) {
+                if (name == INPUT_NAMES[i]) idx = i;
+            }
+            if (idx < 0) {
+                std::cerr << "[TREE-MODEL] unknown input '" << name << "'" << std::endl;
+                return false;
+            }
+            f.input = static_cast<Input>(idx);
+
+            if (jf.contains("equals")) {
+                f.oneHot = true;
+                f.equalsStr = jf.at("equals").get<std::string>();
+                if (f.input != REQUEST_METHOD) f.equalsNum = std::strtod(f.equalsStr.c_str(), nullptr);
+            } else {
+                if (f.input == REQUEST_METHOD) {
+                    std::cerr << "[TREE-MODEL] request_method must be one-hot encoded" << std::endl;
+                    return false;
+                }
+                f.mul = jf.value("mul", 1.0);
+                f.add = jf.value("add", 0.0);
+            }
+            features.push_back(std::move(f));
+        }
+        if (features.empty() || features.size() > MAX_FEATURES) {
+            std::cerr << "[TREE-MODEL] bad feature count " << features.size() << std::endl;
+            return false;
+        }
+
+        auto feat = j.at("node_feature").get<std::vector<std::uint32_t>>();
+        auto thr = j.at("node_threshold").get<std::vector<float>>();
+        auto left = j.at("node_left").get<std::vector<std::uint32_t>>();
+        auto right = j.at("node_right").get<std::vector<std::uint32_t>>();
+        auto value = j.at("node_value").get<std::vector<float>>();
+
+        std::size_t n = feat.size();
+        if (thr.size() != n || left.size() != n || right.size() != n || value.size() != n) {
+            std::cerr << "[TREE-MODEL] node arrays have different sizes" << std::endl;
+            return false;
+        }
+
+        std::vector<Node> nodes(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (feat[i] >= features.size() || left[i] >= n || right[i] >= n) {
+                std::cerr << "[TREE-MODEL] node " << i << " out of range" << std::endl;
+                return false;
+            }
+            nodes[i] = Node{thr[i], feat[i], {left[i], right[i]}, value[i]};
+        }
+
+        auto roots = j.at("tree_root").get<std::vector<std::uint32_t>>();
+        auto depths = j.at("tree_depth").get<std::vector<std::uint8_t>>();
+        auto groups = j.at("tree_group").get<std::vector<std::uint16_t>>();
+        auto base = j.at("base_margin").get<std::vector<float>>();
+        std::size_t nGroups = j.at("groups").get<std::size_t>();
+
+        if (roots.empty() || depths.size() != roots.size() || groups.size() != roots.size() ||
+            nGroups == 0 || nGroups > MAX_GROUPS || base.size() != nGroups) {
+            std::cerr << "[TREE-MODEL] bad tree table" << std::endl;
+            return false;
+        }
+        for (std::size_t t = 0; t < roots.size(); ++t) {
+            if (roots[t] >= n || groups[t] >= nGroups) {
+                std::cerr << "[TREE-MODEL] tree " << t << " out of range" << std::endl;
+                return false;
+            }
+        }
+
+        auto classes = j.at("classes").get<std::vector<std::string>>();
+        std::size_t needClasses = nGroups == 1 ? 2 : nGroups;
+        if (classes.size() != needClasses) {
+            std::cerr << "[TREE-MODEL] expected " << needClasses << " classes, got "
+                      << classes.size() << std::endl;
+            return false;
+        }
+        std::vector<SchedAlgo> classAlgo(classes.size(), SchedAlgo::FIFO);
+        std::vector<bool> classValid(classes.size(), false);
+        for (std::size_t c = 0; c < classes.size(); ++c) {
+            SchedAlgo a;
+            if (parseSchedAlgo(classes[c], a)) {
+                classAlgo[c] = a;
+                classValid[c] = true;
+            }
+        }
+
+        features_ = std::move(features);
+        nodes_ = std::move(nodes);
+        roots_ = std::move(roots);
+        depths_ = std::move(depths);
+        groups_ = std::move(groups);
+        baseMargin_ = std::move(base);
+        classAlgo_ = std::move(classAlgo);
+        classValid_ = std::move(classValid);
+
+    } catch (const std::exception& e) {
+        std::cerr << "[TREE-MODEL] parse error in " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    std::cout << "[TREE-MODEL] loaded " << roots_.size() << " trees / " << nodes_.size()
+              << " nodes from " << path << std::endl;
+    return true;
+}
+
+bool TreeModel::predict(const AIFeatures& f, SchedAlgo& out) const {
+    if (roots_.empty()) return false;
+
+    const double raw[INPUT_COUNT] = {
+        f.cpu,
+        (double)f.queue_len,
+        (double)f.queue_bin,
+        0.0,  // request_method: chỉ dùng qua one-hot
+        (double)f.request_path_length,
+        f.estimated_workload,
+        (double)f.req_size,
+    };
+    const char* method = f.request_method ? f.request_method : "";
+
+    float x[MAX_FEATURES];
+    for (std::size_t i = 0; i < features_.size(); ++i) {
+        const Feature& ft = features_[i];
+        if (!ft.oneHot) {
+            x[i] = (float)(raw[ft.input] * ft.mul + ft.add);  // như XGBoost: tính double rồi ép float
+        } else if (ft.input == REQUEST_METHOD) {
+            x[i] = std::strcmp(method, ft.equalsStr.c_str()) == 0 ? 1.0f : 0.0f;
+        } else {
+            x[i] = raw[ft.input] == ft.equalsNum ? 1.0f : 0.0f;
+        }
+    }
+
+    float margin[MAX_GROUPS];
+    std::copy(baseMargin_.begin(), baseMargin_.end(), margin);
+
+    const Node* nodes = nodes_.data();
+    for (std::size_t t = 0; t < roots_.size(); ++t) {
+        std::uint32_t i = roots_[t];
+        for (std::uint8_t d = depths_[t]; d > 0; --d) {
+            const Node& nd = nodes[i];
+            i = nd.child[!(x[nd.feature] < nd.threshold)];
+        }
+        margin[groups_[t]] += nodes[i].value;
+    }
+
+    std::size_t best;
+    if (baseMargin_.size() == 1) {
+        best = margin[0] > 0.0f ? 1 : 0;
+    } else {
+        best = 0;
+        for (std::size_t g = 1; g < baseMargin_.size(); ++g) {
+            if (margin[g] > margin[best]) best = g;
+        }
+    }
+
+    if (!classValid_[best]) return false;
+    out = classAlgo_[best];
+    return true;
+}
+
+std::shared_ptr<const TreeModel> TreeModel::shared() {
+    static std::once_flag once;
+    static std::shared_ptr<const TreeModel> instance;
+
+    std::call_once(once, [] {
+        const char* env = std::getenv("SCHED_MODEL_PATH");
+        std::string path = env && *env ? env : MODEL_PATH_DEFAULT;
+
+        auto m = std::make_shared<TreeModel>();
+        if (!m->load(path)) {
+            std::cerr << "[TREE-MODEL] embedded model unavailable, using remote AI" << std::endl;
+        }
+        instance = m;
+    });
+    return instance;
+}
@@ -0,0 +1,81 @@
+#include "core/ChunkedWriter.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "core/SslIO.hpp"
+
+// Chừa chỗ đầu buffer cho dòng kích thước chunk ("<hex>\r\n"), ghép header + data
+// + CRLF thành 1 lần SSL_write (1 TLS record) thay vì 3
+static constexpr std::size_t HEAD_ROOM = 18;
+
+ChunkedWriter::ChunkedWriter(Connection& conn, bool chunked, std::size_t bufferSize)
+    : conn(conn), chunked(chunked), capacity(std::max<std::size_t>(bufferSize, 256)) {
+    buffer.reserve(HEAD_ROOM + capacity + 16);
+    buffer.assign(HEAD_ROOM, '\0');
+}
+
+bool ChunkedWriter::begin(Response& res) {
+    res.chunked = chunked;
+    res.closeDelimited = !chunked;
+    res.file.reset();
+    if (!chunked) {
+        // Không có cách báo hết body ngoài đóng connection (Content-Length: 0 sẽ cắt mất body)
+        res.headers.erase("Keep-Alive");
+        res.headers.erase("Connection");
+        res.connectionHeaders = Response::CLOSE_HEADER;
+    }
+
+    thread_local std::string scratch;
+    iovec iov[Response::MAX_IOV];
+    int n = res.toIovecs(iov, scratch);
+    failed = !SslIO::sendv(conn, iov, n);
+    return !failed;
+}
+
+bool ChunkedWriter::write(const char* data, std::size_t len) {
+    while (len > 0 && !failed) {
+        std::size_t space = HEAD_ROOM + capacity - buffer.size();
+        std::size_t n = std::min(space, len);
+        buffer.append(data, n);
+        data += n;
+        len -= n;
+
+        if (buffer.size() == HEAD_ROOM + capacity) flush();
+    }
+    return !failed;
+}
+
+bool ChunkedWriter::sendBuffered(bool last) {
+    if (failed) return false;
+
+    std::size_t n = buffer.size() - HEAD_ROOM;
+    std::size_t start = HEAD_ROOM;
+
+    if (chunked) {
+        if (n > 0) {
+            char hex[HEAD_ROOM + 1];
+            int h = std::snprintf(hex, sizeof(hex), "%zx\r\n", n);
+            start = HEAD_ROOM - (std::size_t)h;
+            std::memcpy(&buffer[start], hex, (std::size_t)h);
+            buffer.append("\r\n");
+        }
+        // Chunk cuối đi chung với phần data còn lại
+        if (last) buffer.append("0\r\n\r\n");
+    }
+
+    if (buffer.size() > start) {
+        failed = !SslIO::send(conn, buffer.data() + start, buffer.size() - start);
+    }
+    buffer.resize(HEAD_ROOM);
+    return !failed;
+}
+
+bool ChunkedWriter::flush() {
+    return sendBuffered(false);
+}
+
+bool ChunkedWriter::finish() {
+    return sendBuffered(true);
+}
@@ -0,0 +1,31 @@
+#include "core/Connection.hpp"
+
+#include <unistd.h>
+
+#include <openssl/ssl.h>
+
+Connection::Connection(int fd_, SSL* ssl_) : fd(fd_), ssl(ssl_) {
+    touch();
+    acceptedAt = lastActive;
+    handshakeDoneAt = acceptedAt;
+}
+
+Connection::~Connection() {
+    close();
+}
+
+void Connection::close() {
+    if (ssl) {
+        // Chỉ gửi close_notify khi handshake đã xong
+        if (SSL_is_init_finished(ssl)) {
+            SSL_shutdown(ssl);
+        }
+        SSL_free(ssl);
+        ssl = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    state = State::Closed;
+}
@@ -1,58 +1,167 @@
 #include "core/HttpParser.hpp"
-#include <algorithm>
-#include <sstream>
 
-static inline void trimCRLF(std::string& s) {
-    // remove trailing \r or \n
-    while (!s.empty() && (s.back() == '\r' || s.back() == '\n')) {
-        s.pop_back();
-    }
-}
+#include <strings.h>
 
-Request HttpParser::parse(const std::string& raw) {
-    Request req;
-    std::istringstream stream(raw);
-    std::string line;
+#include <cstring>
 
-    // -------- Parse request line --------
-    if (std::getline(stream, line)) {
-        trimCRLF(line); // remove trailing \r
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HTTP_PARSER_X86 1
+#endif
 
-        std::istringstream firstLine(line);
-        firstLine >> req.method >> req.path >> req.version;
+// =======================
+//  Tìm byte bằng SIMD
+// =======================
+#ifdef HTTP_PARSER_X86
+static const char* findByteSse2(const char* p, const char* end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+        p += 16;
+    }
+    for (; p < end; ++p) {
+        if (*p == c) return p;
+    }
+    return nullptr;
+}
 
-        trimCRLF(req.method);
-        trimCRLF(req.path);
-        trimCRLF(req.version);
+__attribute__((target("avx2")))
+static const char* findByteAvx2(const char* p, const char* end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 32;
     }
+    return findByteSse2(p, end, c);
+}
+#endif
 
-    // -------- Parse headers --------
-    while (std::getline(stream, line)) {
-        trimCRLF(line);
+const char* HttpParser::findByte(const char* p, const char* end, char c) {
+#ifdef HTTP_PARSER_X86
+    // Chọn 1 lần theo CPU đang chạy
+    static const auto impl = __builtin_cpu_supports("avx2") ? findByteAvx2 : findByteSse2;
+    return impl(p, end, c);
+#else
+    return static_cast<const char*>(std::memchr(p, c, static_cast<std::size_t>(end - p)));
+#endif
+}
 
-        if (line.empty()) break; // end of headers (after \r\n)
+// =======================
+//  Parser
+// =======================
+void HttpParser::reset() {
+    phase = Phase::RequestLine;
+    lineStart = 0;
+    scanPos = 0;
+    headerEndPos = 0;
+    contentLen = 0;
+    hasContentLength = false;
+    hasTransferEncoding = false;
+    isChunked = false;
+    req = Request();
+    req.headers.reserve(16);
+}
+
+Request HttpParser::take() {
+    Request out = std::move(req);
+    reset();
+    return out;
+}
 
-        auto colon = line.find(':');
-        if (colon == std::string::npos) continue;
+HttpParser::Status HttpParser::feed(const std::string& buf) {
+    if (phase == Phase::Done) return Status::Done;
 
-        std::string key = line.substr(0, colon);
-        std::string value = line.substr(colon + 1);
+    const char* base = buf.data();
+    const char* end = base + buf.size();
 
-        // trim spaces
-        while (!value.empty() && value.front() == ' ')
-            value.erase(value.begin());
+    while (true) {
+        // Chỉ quét phần chưa quét lần trước
+        const char* nl = findByte(base + scanPos, end, '\n');
+        if (!nl) {
+            scanPos = buf.size();
+            return Status::Incomplete;
+        }
 
-        trimCRLF(key);
-        trimCRLF(value);
+        std::size_t lf = static_cast<std::size_t>(nl - base);
+        std::size_t b = lineStart;
+        std::size_t e = (lf > b && base[lf - 1] == '\r') ? lf - 1 : lf;
+        lineStart = scanPos = lf + 1;
 
-        req.headers[key] = value;
+        if (phase == Phase::RequestLine) {
+            // Bỏ qua dòng trống trước request line (RFC 9112 §2.2)
+            if (e == b) continue;
+            if (!parseRequestLine(base, b, e)) return Status::Error;
+            phase = Phase::Headers;
+            continue;
+        }
+
+        // Dòng trống: hết header
+        if (e == b) {
+            // Có cả Transfer-Encoding và Content-Length -> không rõ body dài bao nhiêu,
+            // từ chối luôn (request smuggling). TE mà chunked không đứng cuối cũng vậy.
+            if (hasTransferEncoding && (hasContentLength || !isChunked)) return Status::Error;
+            phase = Phase::Done;
+            headerEndPos = lineStart;
+            return Status::Done;
+        }
+        if (!parseHeaderLine(base, b, e)) return Status::Error;
     }
+}
+
+bool HttpParser::parseRequestLine(const char* base, std::size_t b, std::size_t e) {
+    // METHOD SP PATH SP VERSION
+    const char* line = base + b;
+    const char* lineEnd = base + e;
 
-    // -------- Parse body (read raw body exactly as received) --------
-    std::string body((std::istreambuf_iterator<char>(stream)),
-                    std::istreambuf_iterator<char>());
+    const char* sp1 = static_cast<const char*>(std::memchr(line, ' ', lineEnd - line));
+    if (!sp1 || sp1 == line) return false;
+    const char* sp2 = static_cast<const char*>(std::memchr(sp1 + 1, ' ', lineEnd - sp1 - 1));
+    if (!sp2 || sp2 == sp1 + 1 || sp2 + 1 >= lineEnd) return false;
+    if (lineEnd - sp2 - 1 < 5 || std::memcmp(sp2 + 1, "HTTP/", 5) != 0) return false;
+
+    req.methodSpan = {b, static_cast<std::size_t>(sp1 - line)};
+    req.pathSpan = {static_cast<std::size_t>(sp1 + 1 - base), static_cast<std::size_t>(sp2 - sp1 - 1)};
+    req.versionSpan = {static_cast<std::size_t>(sp2 + 1 - base), static_cast<std::size_t>(lineEnd - sp2 - 1)};
+    return true;
+}
 
-    req.body = body;
+bool HttpParser::parseHeaderLine(const char* base, std::size_t b, std::size_t e) {
+    const char* colon = findByte(base + b, base + e, ':');
 
-    return req;
+    // Dòng không có ':' hoặc tên rỗng -> bỏ qua (giống parser cũ)
+    if (!colon || colon == base + b) return true;
+
+    std::size_t nameEnd = static_cast<std::size_t>(colon - base);
+    std::size_t vb = nameEnd + 1;
+    std::size_t ve = e;
+    while (vb < ve && (base[vb] == ' ' || base[vb] == '\t')) ++vb;
+    while (ve > vb && (base[ve - 1] == ' ' || base[ve - 1] == '\t')) --ve;
+
+    if (req.headers.size() >= MAX_HEADERS) return false;
+    req.headers.push_back({{b, nameEnd - b}, {vb, ve - vb}});
+
+    // Content-Length: nhiều giá trị khác nhau -> từ chối (request smuggling)
+    if (nameEnd - b == 14 && strncasecmp(base + b, "Content-Length", 14) == 0) {
+        if (vb == ve || ve - vb > 18) return false;
+        long long val = 0;
+        for (std::size_t i = vb; i < ve; ++i) {
+            if (base[i] < '0' || base[i] > '9') return false;
+            val = val * 10 + (base[i] - '0');
+        }
+        if (hasContentLength && contentLen != val) return false;
+        contentLen = val;
+        hasContentLength = true;
+    } else if (nameEnd - b == 17 && strncasecmp(base + b, "Transfer-Encoding", 17) == 0) {
+        // "gzip, chunked": chỉ quan tâm coding cuối cùng
+        std::size_t last = ve;
+        while (last > vb && base[last - 1] != ',') --last;
+        while (last < ve && (base[last] == ' ' || base[last] == '\t')) ++last;
+        hasTransferEncoding = true;
+        isChunked = ve - last == 7 && strncasecmp(base + last, "chunked", 7) == 0;
+    }
+    return true;
 }
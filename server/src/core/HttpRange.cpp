@@ -0,0 +1,113 @@
+#include "core/HttpRange.hpp"
+
+#include <strings.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+namespace HttpRange {
+
+static std::string trim(std::string_view s, std::size_t b, std::size_t e) {
+    while (b < e && std::isspace((unsigned char)s[b])) ++b;
+    while (e > b && std::isspace((unsigned char)s[e - 1])) --e;
+    return std::string(s.substr(b, e - b));
+}
+
+// Chỉ nhận chữ số (không dấu, không khoảng trắng), false nếu rỗng/tràn
+static bool parseNumber(const std::string& s, unsigned long long& out) {
+    if (s.empty() || s.size() > 19) return false;
+    out = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') return false;
+        out = out * 10 + (unsigned long long)(c - '0');
+    }
+    return true;
+}
+
+Result parse(std::string_view header, std::size_t fileSize, std::vector<ByteRange>& ranges) {
+    ranges.clear();
+
+    std::size_t eq = header.find('=');
+    if (eq == std::string_view::npos) return Result::Ignore;
+    if (strcasecmp(trim(header, 0, eq).c_str(), "bytes") != 0) return Result::Ignore;
+
+    const unsigned long long size = fileSize;
+    std::size_t specs = 0;
+    std::size_t pos = eq + 1;
+
+    while (pos <= header.size()) {
+        std::size_t comma = header.find(',', pos);
+        if (comma == std::string_view::npos) comma = header.size();
+        std::string spec = trim(header, pos, comma);
+        pos = comma + 1;
+
+        if (spec.empty()) continue;  // cho phép ",," thừa
+        if (++specs > MAX_RANGES) return Result::Ignore;
+
+        std::size_t dash = spec.find('-');
+        if (dash == std::string::npos) return Result::Ignore;
+        std::string first = spec.substr(0, dash);
+        std::string last = spec.substr(dash + 1);
+
+        unsigned long long a = 0, b = 0;
+        if (first.empty()) {
+            // "-N": N byte cuối
+            if (!parseNumber(last, b)) return Result::Ignore;
+            if (b == 0 || size == 0) continue;
+            if (b > size) b = size;
+            ranges.push_back({(off_t)(size - b), (std::size_t)b});
+            continue;
+        }
+
+        if (!parseNumber(first, a)) return Result::Ignore;
+        if (last.empty()) {
+            b = size ? size - 1 : 0;
+        } else {
+            if (!parseNumber(last, b) || b < a) return Result::Ignore;
+            if (size && b >= size) b = size - 1;
+        }
+        if (a >= size) continue;  // nằm ngoài file
+        ranges.push_back({(off_t)a, (std::size_t)(b - a + 1)});
+    }
+
+    if (specs == 0) return Result::Ignore;
+    return ranges.empty() ? Result::Unsatisfiable : Result::Satisfiable;
+}
+
+std::string makeETag(std::size_t size, const struct timespec& mtime) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "\"%zx-%llx%09lx\"", size, (unsigned long long)mtime.tv_sec,
+                  (unsigned long)mtime.tv_nsec);
+    return buf;
+}
+
+std::string formatHttpDate(std::time_t t) {
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    char buf[64];
+    std::size_t n = std::strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return std::string(buf, n);
+}
+
+bool ifRangeMatches(std::string_view ifRange, const std::string& etag, std::time_t mtime) {
+    std::string v = trim(ifRange, 0, ifRange.size());
+    if (v.empty()) return false;
+
+    // Entity-tag: chỉ so sánh mạnh, weak ("W/...") không bao giờ khớp
+    if (v[0] == '"' || v.rfind("W/", 0) == 0) return v == etag;
+
+    // HTTP-date: phải trùng đúng Last-Modified
+    std::tm tm{};
+    const char* end = strptime(v.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    if (!end || *end != '\0') return false;
+    return timegm(&tm) == mtime;
+}
+
+std::string contentRange(const ByteRange& r, std::size_t fileSize) {
+    return "bytes " + std::to_string((unsigned long long)r.offset) + "-" +
+           std::to_string((unsigned long long)r.offset + r.length - 1) + "/" +
+           std::to_string(fileSize);
+}
+
+}  // namespace HttpRange
@@ -2,10 +2,13 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <unistd.h>
 
@@ -14,20 +17,32 @@
 #include <cstring>
 #include <ctime>
 #include <filesystem>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <thread>
 
+#include "core/ChunkedWriter.hpp"
 #include "core/HttpParser.hpp"
+#include "core/HttpRange.hpp"
+#include "core/Reactor.hpp"
 #include "core/Response.hpp"
-#include "core/Socket.hpp"
+#include "core/SslIO.hpp"
+#include "core/StaticCache.hpp"
+#include "core/UploadFile.hpp"
+#include "monitor/LogSegment.hpp"
 #include "monitor/Logger.hpp"
+#include "monitor/Metrics.hpp"
 #include "monitor/SystemMetrics.hpp"
+#include "monitor/Tracer.hpp"
+#include "scheduler/AdaptiveScheduler.hpp"
 #include "scheduler/Scheduler.hpp"
 #include "scheduler/SchedulerFactory.hpp"
 #include "threadpool/ThreadPool.hpp"
+#include "tls/HandshakePool.hpp"
+#include "tls/TlsSessionCache.hpp"
+
+#include <nlohmann/json.hpp>
 
 // OpenSSL
 #include <openssl/err.h>
@@ -36,6 +51,9 @@
 // =======================
 //  Helpers
 // =======================
+static const char* LOG_PATH = "data/logs/http_server_log.csv";
+static const char* LOG_SEGMENT_PREFIX = "data/logs/http_server_log";  // log_format = binary
+
 // static inline long long nowMs() {
 //     using namespace std::chrono;
 //     return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
@@ -45,68 +63,136 @@
 //     std::cout << "[" << nowMs() << "ms]"                      \
 //               << "[TID " << std::this_thread::get_id() << "]" \
 //               << "[" << tag << "] " << msg << std::endl;
-// Gửi toàn bộ buffer qua SSL
-static void sendAllSSL(SSL* ssl, const char* data, size_t len) {
-    size_t total = 0;
-
-    while (total < len) {
-        size_t remain = len - total;
-        int sent = SSL_write(ssl, data + total, static_cast<int>(remain));
-        if (sent <= 0) {
-            int err = SSL_get_error(ssl, sent);
-
-            if (err == SSL_ERROR_WANT_WRITE || err == SSL_ERROR_WANT_READ) {
-                // retry nhẹ
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                continue;
-            }
-            ERR_print_errors_fp(stderr);
-            break;
-        }
 
-        total += static_cast<size_t>(sent);
+// Nạp fd đã mở vào response (nhận quyền sở hữu fd):
+// file lớn -> FileBody (gửi zero-copy), file nhỏ -> đọc vào body
+static void loadOpenFile(Response& res, int fd, std::size_t size, std::size_t zeroCopyMin) {
+    if (size >= zeroCopyMin) {
+        res.file = std::make_shared<FileBody>(fd, 0, size);
+        return;
+    }
+
+    res.body.resize(size);
+    std::size_t got = 0;
+    while (got < size) {
+        ssize_t n = pread(fd, &res.body[got], size - got, static_cast<off_t>(got));
+        if (n <= 0) break;
+        got += static_cast<std::size_t>(n);
     }
+    res.body.resize(got);
+    ::close(fd);
 }
 
-// Thời gian ISO8601
-static std::string nowIso8601() {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    std::time_t t = system_clock::to_time_t(now);
-    std::tm tm{};
-    localtime_r(&t, &tm);
-
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
-    return oss.str();
+// Mở file thường, -1 nếu không mở được
+static int openRegular(const std::string& path, struct stat& st) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
 }
 
-// endsWith cho C++17
-static bool endsWith(const std::string& str, const std::string& suffix) {
-    if (suffix.size() > str.size()) return false;
-    return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin());
+// Nạp file vào response, false nếu không mở được file thường
+static bool loadFile(Response& res, const std::string& path, std::size_t zeroCopyMin) {
+    struct stat st {};
+    int fd = openRegular(path, st);
+    if (fd < 0) return false;
+
+    loadOpenFile(res, fd, static_cast<std::size_t>(st.st_size), zeroCopyMin);
+    return true;
+}
+
+// Client có muốn giữ connection không (HTTP/1.1 mặc định keep-alive)
+static bool wantsKeepAlive(const Request& req) {
+    std::string_view conn = req.header("Connection");
+    if (conn.size() == 5 && strncasecmp(conn.data(), "close", 5) == 0) return false;
+    if (conn.size() == 10 && strncasecmp(conn.data(), "keep-alive", 10) == 0) return true;
+    return req.version() == "HTTP/1.1";
+}
+
+// Đường dẫn static -> file trong www/
+static std::string staticPath(std::string_view path) {
+    if (path == "/") return "www/index.html";
+    std::string full = "www";
+    full.append(path);
+    return full;
+}
+
+// Chỉ cache path chuẩn (không "//", ".", "..") để key khớp với đường dẫn inotify báo về
+static bool isCanonicalPath(std::string_view path) {
+    if (path.empty() || path[0] != '/') return false;
+    return path.find("//") == std::string_view::npos && path.find("/./") == std::string_view::npos &&
+           path.find("..") == std::string_view::npos && path.back() != '.';
+}
+
+// /api/file/<name> -> www/files/<name>, "" nếu không phải file API
+static std::string mapToFilePath(std::string_view httpPath) {
+    constexpr std::string_view prefix = "/api/file/";
+
+    if (httpPath.substr(0, prefix.size()) != prefix) {
+        return "";
+    }
+
+    std::string_view name = httpPath.substr(prefix.size());
+
+    // Chặn ../ để tránh ghi lung tung
+    if (name.find("..") != std::string_view::npos || name.find('\\') != std::string_view::npos) {
+        return "";
+    }
+
+    std::string full = "www/files/";
+    full.append(name);
+    return full;
 }
 
-HttpServer::HttpServer(int port, int threadCount, const std::string& algo)
+HttpServer::HttpServer(int port, int threadCount, const std::string& algo,
+                       const ServerOptions& options)
     : port(port),
       threadCount(threadCount),
       isRunning(false),
       nextTaskId(0),
       latencyAvg(0.0),
       sslCtx(nullptr),
-      algoName(algo) {
-    serverSocket = std::make_unique<Socket>();
+      algoName(algo),
+      options(options) {
+    if (this->options.acceptors < 1) this->options.acceptors = 1;
+
+    // 1) Tạo scheduler + 2) ThreadPool nhận scheduler – pull-mode
+    // (chế độ shard scheduler: mỗi shard tự tạo trong setupShards;
+    //  work-stealing: pool tự tạo scheduler cho từng worker)
+    if (this->options.workStealing) {
+        threadPool = std::make_unique<ThreadPool>(threadCount, algoName);
+    } else if (!this->options.shardScheduler) {
+        scheduler = SchedulerFactory::create(algoName);
+        threadPool = std::make_unique<ThreadPool>(threadCount, scheduler.get());
+    }
+
+    if (this->options.staticCacheBytes > 0) {
+        staticCache = std::make_unique<StaticCache>("www", (std::size_t)this->options.staticCacheBytes,
+                                                    (std::size_t)this->options.staticCacheMaxEntry);
+    }
+
+    keepAliveHeaderLines = "Connection: keep-alive\r\nKeep-Alive: timeout=" +
+                           std::to_string(this->options.keepAliveTimeoutSec) +
+                           ", max=" + std::to_string(this->options.maxRequestsPerConn) + "\r\n";
 
-    // 1) Tạo scheduler
-    scheduler = SchedulerFactory::create(algoName);
+    // 3) metrics + logger
+    metrics = std::make_unique<Metrics>();
+    if (this->options.logBinary) {
+        logger = std::make_unique<Logger>(LOG_SEGMENT_PREFIX, std::chrono::milliseconds(this->options.logFlushMs),
+                                          Logger::Format::Binary, (std::size_t)this->options.logSegmentBytes);
+    } else {
+        logger = std::make_unique<Logger>(LOG_PATH, std::chrono::milliseconds(this->options.logFlushMs));
+    }
 
-    // 2) ThreadPool nhận scheduler – pull-mode
-    threadPool = std::make_unique<ThreadPool>(threadCount, scheduler.get());
+    if (this->options.traceEnabled) Tracer::instance().enable((std::size_t)this->options.traceBufferEvents);
 
-    // 3) logger
-    logger = std::make_unique<Logger>("data/logs/http_server_log.csv");
+    // 4) Khởi tạo OpenSSL (tắt TLS -> sslCtx giữ nullptr, reactor nhận HTTP thường)
+    if (!this->options.tls) return;
 
-    // 4) Khởi tạo OpenSSL
     SSL_library_init();
     SSL_load_error_strings();
     OpenSSL_add_all_algorithms();
@@ -123,6 +209,17 @@ HttpServer::HttpServer(int port, int threadCount, const std::string& algo)
             ERR_print_errors_fp(stderr);
             SSL_CTX_free(sslCtx);
             sslCtx = nullptr;
+        } else {
+#ifdef SSL_OP_ENABLE_KTLS
+            // Kernel TLS: cho phép SSL_sendfile (kernel tự mã hóa record)
+            if (this->options.ktls) SSL_CTX_set_options(sslCtx, SSL_OP_ENABLE_KTLS);
+#endif
+
+            // Session resumption: client quay lại bỏ qua full handshake
+            tlsCache = std::make_unique<TlsSessionCache>(
+                (std::size_t)std::max(1, this->options.tlsSessionCacheSize),
+                this->options.tlsTicketRotateSec);
+            tlsCache->attach(sslCtx, this->options.tlsSessionTimeoutSec);
         }
     }
 }
@@ -134,358 +231,496 @@ HttpServer::~HttpServer() {
     }
 }
 
-static long long parseContentLength(const std::string& headers) {
-    // đơn giản, đủ dùng với wrk (không chunked)
-    std::string key = "Content-Length:";
-    auto pos = headers.find(key);
-    if (pos == std::string::npos) return 0;
-
-    pos += key.size();
-    while (pos < headers.size() && (headers[pos] == ' ' || headers[pos] == '\t')) pos++;
+// Ước lượng workload để test SJF / RR / WFQ
+int HttpServer::estimateTaskWorkload(const Request& req) {
+    int w = static_cast<int>(req.path().size());
 
-    long long val = 0;
-    while (pos < headers.size() && isdigit((unsigned char)headers[pos])) {
-        val = val * 10 + (headers[pos] - '0');
-        pos++;
+    // Ưu tiên body nếu có
+    if (!req.body().empty()) {
+        w += static_cast<int>(req.body().size());
     }
-    return val;
+
+    // scale
+    w = w / 10 + 1;
+
+    return w;
 }
 
-std::string HttpServer::readRequestBlockingSSL(SSL* ssl) {
-    std::string data;
-    char buffer[4096];
-
-    // 1) đọc đến khi đủ header
-    while (data.find("\r\n\r\n") == std::string::npos) {
-        int n = SSL_read(ssl, buffer, sizeof(buffer));
-        if (n <= 0) {
-            int err = SSL_get_error(ssl, n);
-            if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) continue;
-            return "";
-        }
-        data.append(buffer, n);
-        if (data.size() > 65536) return "";  // guard header quá lớn
+// Pin thread hiện tại vào 1 core
+static void pinCurrentThread(int core) {
+    unsigned n = std::thread::hardware_concurrency();
+    if (n == 0) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % n, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "[WARN] Cannot pin reactor to core " << core % n << "\n";
     }
+}
 
-    // 2) xác định Content-Length
-    size_t headerEnd = data.find("\r\n\r\n");
-    size_t bodyStart = headerEnd + 4;
-    long long contentLen = parseContentLength(data.substr(0, bodyStart));
+bool HttpServer::setupShards() {
+    int n = options.acceptors;
+    int perShardThreads = std::max(1, threadCount / n);
 
-    // guard body
-    if (contentLen < 0 || contentLen > 5 * 1024 * 1024) return "";  // ví dụ cap 5MB
+    if (sslCtx && options.handshakeThreads > 0) {
+        handshakePool =
+            std::make_unique<HandshakePool>(options.handshakeThreads, options.ioTimeoutSec);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->index = i;
 
-    // 3) đọc tiếp đến khi đủ body
-    while (data.size() < bodyStart + (size_t)contentLen) {
-        int n = SSL_read(ssl, buffer, sizeof(buffer));
-        if (n <= 0) {
-            int err = SSL_get_error(ssl, n);
-            if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) continue;
-            return "";
+        if (options.shardScheduler && !options.workStealing) {
+            shard->ownScheduler = SchedulerFactory::create(algoName);
+            shard->ownThreadPool =
+                std::make_unique<ThreadPool>(perShardThreads, shard->ownScheduler.get());
+            shard->threadPool = shard->ownThreadPool.get();
+        } else {
+            shard->threadPool = threadPool.get();
         }
-        data.append(buffer, n);
-    }
 
-    return data;
-}
+        Shard* sp = shard.get();
+        shard->reactor = std::make_unique<Reactor>(
+            sslCtx, options, [this, sp](std::shared_ptr<Connection> conn, Request req) {
+                enqueueRequest(*sp, std::move(conn), std::move(req));
+            });
 
-// Ước lượng workload để test SJF / RR / WFQ
-int HttpServer::estimateTaskWorkload(const Request& req) {
-    int w = static_cast<int>(req.path.size());
+        shard->reactor->setHandshakePool(handshakePool.get());
 
-    // Ưu tiên body nếu có
-    if (!req.body.empty()) {
-        w += static_cast<int>(req.body.size());
-    }
+        // PUT/POST vào file API: body stream thẳng xuống file tạm
+        shard->reactor->setUploadTarget([](std::string_view method, std::string_view path) {
+            if (method != "PUT" && method != "POST") return std::string();
+            return mapToFilePath(path);
+        });
 
-    // scale
-    w = w / 10 + 1;
+        // Mỗi reactor 1 listening socket riêng, kernel chia connection (SO_REUSEPORT)
+        if (!shard->reactor->listen(port)) {
+            std::cerr << "[ERROR] Reactor " << i << " cannot listen on port " << port << "\n";
+            return false;
+        }
 
-    return w;
+        shards.push_back(std::move(shard));
+    }
+    return true;
+}
+
+void HttpServer::runShard(Shard& shard) {
+    if (options.pinAcceptors) pinCurrentThread(shard.index);
+    Tracer::setThreadName("reactor");
+    shard.reactor->run();
 }
 
 void HttpServer::start() {
     std::cout << "[SERVER] Starting on port " << port << "...\n";
 
-    if (!sslCtx) {
+    if (options.tls && !sslCtx) {
         std::cerr << "[ERROR] SSL_CTX not initialized. HTTPS cannot start.\n";
         return;
     }
 
-    if (!serverSocket->bind(port)) {
-        std::cerr << "[ERROR] Cannot bind port " << port << "\n";
-        return;
-    }
-
-    if (!serverSocket->listen()) {
-        std::cerr << "[ERROR] Listen failed\n";
+    // Reactor: accept + SSL handshake + đọc request (non-blocking, epoll)
+    if (!setupShards()) {
+        shards.clear();
         return;
     }
 
     isRunning = true;
 
-    std::cout << "[SERVER] HTTPS Accept loop running...\n";
-
-    // Vòng accept: mỗi kết nối -> SSL handshake -> đọc request -> Task -> scheduler -> threadpool
-    while (isRunning) {
-        int clientFd = serverSocket->acceptClient();
-
-        // LOGX("NET", "Set SO_SNDTIMEO/SO_RCVTIMEO = 5s");
-
-        if (clientFd < 0) {
-            if (isRunning) {
-                std::cerr << "[WARN] accept() failed, errno=" << errno << "\n";
-            }
-            continue;
-        }
+    std::cout << "[SERVER] " << (sslCtx ? "HTTPS" : "HTTP") << " event loop running: acceptors=" << shards.size()
+              << " pin=" << (options.pinAcceptors ? "on" : "off")
+              << " scheduler="
+              << (options.workStealing ? "work-stealing" : options.shardScheduler ? "per-shard" : "shared")
+              << "\n";
+
+    // Mỗi kết nối: epoll -> SSL handshake -> đọc request -> Task -> scheduler -> threadpool
+    // Shard 0 chạy trên thread gọi start(), các shard còn lại mỗi cái 1 thread
+    for (std::size_t i = 1; i < shards.size(); ++i) {
+        Shard* sp = shards[i].get();
+        sp->thread = std::thread([this, sp]() { runShard(*sp); });
+    }
 
-        // Tắt Nagle cho client để giảm latency
-        int flag = 1;
-        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
-        // timeout send/recv để tránh treo vô hạn
-        timeval tv{};
-        tv.tv_sec = 5;
-        tv.tv_usec = 0;
-        setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-        setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-
-        // Tạo SSL object cho client
-        SSL* ssl = SSL_new(sslCtx);
-        if (!ssl) {
-            std::cerr << "[SSL] SSL_new failed\n";
-            close(clientFd);
-            continue;
-        }
-        SSL_set_fd(ssl, clientFd);
+    runShard(*shards[0]);
 
-        int sslAcceptRet = SSL_accept(ssl);
-        if (sslAcceptRet <= 0) {
-            std::cerr << "[SSL] SSL_accept failed\n";
-            ERR_print_errors_fp(stderr);
-            SSL_free(ssl);
-            close(clientFd);
-            continue;
-        }
+    for (auto& shard : shards) {
+        if (shard->thread.joinable()) shard->thread.join();
+    }
+}
 
-        // Đọc request từ client qua SSL
-        std::string raw = readRequestBlockingSSL(ssl);
-        if (raw.empty()) {
-            std::cout << "[DEBUG] empty or invalid request, closing client\n";
-            SSL_shutdown(ssl);
-            SSL_free(ssl);
-            close(clientFd);
-            continue;
-        }
+// Request đang chờ worker: nằm trên heap, Task chỉ giữ con trỏ (closure 16 byte)
+struct PendingRequest {
+    std::shared_ptr<Connection> conn;
+    Request req;
+    ThreadPool* pool;
+    Reactor* reactor;
+    std::uint32_t id;
+    int est;
+    SchedAlgo algoAtEnqueue;
+    std::size_t qLenAtEnqueue;
+};
+
+void HttpServer::enqueueRequest(Shard& shard, std::shared_ptr<Connection> conn, Request req) {
+    ThreadPool* threadPool = shard.threadPool;
+
+    int est = estimateTaskWorkload(req);
+    int currentTaskId = nextTaskId++;
+    std::size_t qLenAtEnqueue = threadPool->incrementPendingTasks();
+    SchedAlgo algo_enqueue = threadPool->currentAlgorithm();
+
+    // 3) Tạo Task
+    HttpMethod method = parseHttpMethod(req.method());
+    auto pathLen = static_cast<std::uint32_t>(req.path().size());
+
+    // req_size: ưu tiên body, fallback path
+    std::size_t reqSize = req.body().size();
+    if (reqSize == 0) reqSize = req.path().size();
+    reqSize = std::min<std::size_t>(reqSize, UINT32_MAX);
+
+    // ================================
+    // Assign weight for WFQ
+    // ================================
+    int weight;
+
+    // 1. Base weight theo độ nặng request
+    if (est <= 50) {
+        weight = 3;  // request nhẹ
+    } else if (est <= 200) {
+        weight = 2;  // trung bình
+    } else {
+        weight = 1;  // request nặng
+    }
 
-        // Parse request
-        Request req = HttpParser::parse(raw);
-
-        int est = estimateTaskWorkload(req);
-        int currentTaskId = nextTaskId++;
-        auto startTime = std::chrono::steady_clock::now();
-        std::size_t qLenAtEnqueue = threadPool->incrementPendingTasks();
-        std::string algo_enqueue = scheduler->currentAlgorithm();
-
-        // 3) Tạo Task
-        std::string method = req.method;
-        int pathLen = static_cast<int>(req.path.size());
-
-        // req_size: ưu tiên body, fallback path
-        std::size_t reqSize = req.body.size();
-        if (reqSize == 0) reqSize = req.path.size();
-
-        // ================================
-        // Assign weight for WFQ
-        // ================================
-        int weight;
-
-        // 1. Base weight theo độ nặng request
-        if (est <= 50) {
-            weight = 3;  // request nhẹ
-        } else if (est <= 200) {
-            weight = 2;  // trung bình
-        } else {
-            weight = 1;  // request nặng
-        }
+    // 2. Ưu tiên thêm cho GET (thường nhẹ, phổ biến)
+    if (method == HttpMethod::GET) {
+        weight += 1;
+    }
 
-        // 2. Ưu tiên thêm cho GET (thường nhẹ, phổ biến)
-        if (method == "GET") {
-            weight += 1;
-        }
+    // 3. Giới hạn weight để tránh quá ưu tiên
+    weight = std::min(weight, 5);
+
+    req.timeline.enqueued = std::chrono::steady_clock::now();
+    std::shared_ptr<Connection> keepConn = conn;  // pool đầy -> reactor trả 503 trên connection này
+    auto job = std::unique_ptr<PendingRequest>(new PendingRequest{
+        std::move(conn), std::move(req), threadPool, shard.reactor.get(),
+        static_cast<std::uint32_t>(currentTaskId), est, algo_enqueue, qLenAtEnqueue});
+
+    Task task(static_cast<std::uint32_t>(currentTaskId), est, weight, algo_enqueue, method,
+              pathLen,                                // request_path_length
+              static_cast<std::uint32_t>(reqSize),    // req_size
+              [this, job = std::move(job)]() {
+                  RequestTimeline& tl = job->req.timeline;
+                  tl.dequeued = std::chrono::steady_clock::now();
+                  std::uint64_t cpuBefore = SystemMetrics::threadCpuNs();
+                  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                  const Request& req = job->req;
+                  Connection& conn = *job->conn;
+
+                  // 100 Continue reactor chưa gửi hết (socket đầy): gửi nốt trước response.
+                  // TLS phải gọi lại SSL_write với đúng phần còn lại -> không bỏ được
+                  if (!conn.outBuf.empty()) {
+                      SslIO::send(conn, conn.outBuf.data() + conn.outPos, conn.outBuf.size() - conn.outPos);
+                      conn.outBuf.clear();
+                      conn.outPos = 0;
+                  }
+                  std::uint64_t sentBefore = conn.bytesSent;
+                  conn.lastStatus = 0;
+
+                  // Xử lý request (connection đã handshake xong)
+                  // keep-alive -> trả connection về reactor đọc request kế tiếp
+                  // (đọc status/bytes trước resume: sau đó reactor có thể dùng lại connection)
+                  bool keep = handleClient(conn, req, tl);
+                  SystemMetrics::addBusyNs(SystemMetrics::threadCpuNs() - cpuBefore);
+                  tl.flushed = std::chrono::steady_clock::now();
+                  if (tl.handlerDone == RequestTimeline::TimePoint{}) tl.handlerDone = tl.flushed;
+                  int status = conn.lastStatus;
+                  std::uint64_t bytesOut = conn.bytesSent - sentBefore;
+                  if (keep) {
+                      job->reactor->resume(job->conn);
+                  } else {
+                      job->conn->close();
+                  }
+
+                  double respMs = tl.responseMs();
+
+                  // EWMA latency (nhiều worker cùng cập nhật -> CAS)
+                  double latAvg = this->latencyAvg.load(std::memory_order_relaxed);
+                  while (!this->latencyAvg.compare_exchange_weak(latAvg, latAvg * 0.9 + respMs * 0.1,
+                                                                 std::memory_order_relaxed)) {
+                  }
+                  latAvg = latAvg * 0.9 + respMs * 0.1;
+
+                  SchedAlgo algoRun = job->pool->currentAlgorithm();
+                  if (Tracer::enabled()) {
+                      Tracer::async("request", "queued", job->id, tl.enqueued, tl.dequeued,
+                                    {"req", job->id}, {"algo_enqueue", schedAlgoName(job->algoAtEnqueue)});
+                      Tracer::complete("request", "execute", tl.dequeued, tl.flushed, {"req", job->id},
+                                       {"status", status}, {"algo_run", schedAlgoName(algoRun)});
+                      Tracer::complete("request", "handler", tl.dequeued, tl.handlerDone, {"req", job->id});
+                      Tracer::complete("request", "write", tl.handlerDone, tl.flushed, {"req", job->id},
+                                       {"bytes", (std::int64_t)bytesOut});
+                  }
+                  if (this->metrics) {
+                      Metrics::Sample m;
+                      m.route = Metrics::classify(req.method(), req.path());
+                      m.algo = algoRun;
+                      m.status = status;
+                      m.bytesIn = req.body().size();
+                      m.bytesOut = bytesOut;
+                      m.queueWaitUs = (std::uint64_t)(tl.queueMs() * 1000.0);
+                      m.serviceUs = (std::uint64_t)(tl.serviceMs() * 1000.0);
+                      m.writeUs = (std::uint64_t)(tl.writeMs() * 1000.0);
+                      m.readUs = (std::uint64_t)(tl.readMs() * 1000.0);
+                      m.handshakeUs = (std::uint64_t)(tl.handshakeMs() * 1000.0);
+                      m.firstOnConnection = tl.firstOnConnection;
+                      this->metrics->record(m);
+                  }
+
+                  double cpu = SystemMetrics::getCpuUsage();
+                  std::size_t reqSize = req.path().size();
+                  std::size_t queueLen = job->qLenAtEnqueue;
+                  const char* algo_enqueue = schedAlgoName(job->algoAtEnqueue);
+                  const char* algo_run = schedAlgoName(algoRun);
+
+                  if (this->logger) {
+                      LogEntry e;
+                      e.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::system_clock::now().time_since_epoch())
+                                           .count();
+                      e.cpu = cpu;
+                      e.queue_len = queueLen;
+                      e.request_method = parseHttpMethod(req.method());
+                      e.request_path_length = static_cast<std::uint32_t>(req.path().size());
+                      e.estimated_workload = job->est;
+                      e.algo_at_enqueue = job->algoAtEnqueue;
+                      e.algo_at_run = algoRun;
+                      e.req_size = reqSize;
+                      e.response_time_ms = respMs;
+                      e.prev_latency_avg = latAvg;
+                      e.queue_ms = tl.queueMs();
+                      e.service_ms = tl.serviceMs();
+                      e.write_ms = tl.writeMs();
+                      e.handshake_ms = tl.handshakeMs();
+                      e.read_ms = tl.readMs();
+
+                      this->logger->log(e);
+                  }
+
+                  std::cout << "[LOG] cpu=" << cpu << " q=" << queueLen
+                            << " algo_enqueue=" << algo_enqueue << " algo_run=" << algo_run
+                            << " rt=" << respMs << "ms"
+                            << " (queue=" << tl.queueMs() << " service=" << tl.serviceMs()
+                            << " write=" << tl.writeMs() << ")"
+                            << " latAvg=" << latAvg << "ms\n";
+              });
+
+    // enqueue
+    // shared: scheduler chung; work-stealing: inbox của 1 worker
+    // Span bao cả quyết định thuật toán (AI / switch) của AdaptiveScheduler
+    TraceScope span("sched", "enqueue");
+    span.arg(0, {"req", currentTaskId});
+    span.arg(1, {"queue_len", (std::int64_t)qLenAtEnqueue});
+    if (threadPool->trySubmit(task, qLenAtEnqueue)) return;
+
+    // Queue / mọi inbox đều đầy: không chờ trong event loop -> trả 503 rồi đóng,
+    // client thử lại sau Retry-After
+    task = Task{};
+    threadPool->decrementPendingTasks();
+    rejectOverloaded(*shard.reactor, std::move(keepConn));
+}
 
-        // 3. Giới hạn weight để tránh quá ưu tiên
-        weight = std::min(weight, 5);
-
-        Task task(currentTaskId, est, weight, algo_enqueue,
-                  method,   // request_method
-                  pathLen,  // request_path_length
-                  reqSize,  // req_size
-                  [this, ssl, clientFd, req, startTime, est, algo_enqueue, qLenAtEnqueue]() {
-                      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-
-                      auto t0 = startTime;
-
-                      // Xử lý request (đã có SSL + FD)
-                      handleClient(ssl, clientFd, req);
-
-                      auto t1 = std::chrono::steady_clock::now();
-                      double respMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
-
-                      // EWMA latency
-                      this->latencyAvg = this->latencyAvg * 0.9 + respMs * 0.1;
-
-                      double cpu = SystemMetrics::getCpuUsage();
-                      std::size_t reqSize = req.path.size();
-                      std::size_t queueLen = qLenAtEnqueue;
-                      std::string algo_run = this->scheduler->currentAlgorithm();
-
-                      if (this->logger) {
-                          LogEntry e;
-                          e.queue_len = queueLen;
-                          e.timestamp = nowIso8601();
-                          e.cpu = cpu;
-                          e.request_method = req.method;
-                          e.request_path_length = req.path.size();
-                          e.estimated_workload = est;
-                          e.algo_at_enqueue = algo_enqueue;
-                          e.algo_at_run = algo_run;
-                          e.req_size = reqSize;
-                          e.response_time_ms = respMs;
-                          e.prev_latency_avg = this->latencyAvg;
-
-                          this->logger->log(e);
-                      }
-
-                      std::cout << "[LOG] cpu=" << cpu << " q=" << queueLen
-                                << " algo_enqueue=" << algo_enqueue << " algo_run=" << algo_run
-                                << " rt=" << respMs << "ms"
-                                << " latAvg=" << this->latencyAvg << "ms\n";
-                  });
-
-        // enqueue
-        scheduler->enqueue(task, qLenAtEnqueue);
-        threadPool->notifyWorker();
-    }
+void HttpServer::rejectOverloaded(Reactor& reactor, std::shared_ptr<Connection> conn) {
+    // Dựng 1 lần: reactor chỉ copy bytes vào outBuf của connection
+    static const std::string response = [] {
+        Response res;
+        res.statusCode = 503;
+        res.statusText = "Service Unavailable";
+        res.headers["Content-Type"] = "text/plain";
+        res.headers["Retry-After"] = "1";
+        res.connectionHeaders = Response::CLOSE_HEADER;
+        res.body = "Server busy";
+        return res.build();
+    }();
+
+    reactor.sendAndClose(std::move(conn), response);
+    overloadRejected.fetch_add(1, std::memory_order_relaxed);
 }
 
 void HttpServer::stop() {
     isRunning = false;
-    serverSocket->closeSocket();
+    for (auto& shard : shards) {
+        if (shard->reactor) shard->reactor->stop();
+    }
+    if (handshakePool) handshakePool->stop();
     std::cout << "[SERVER] Stopped.\n";
 }
 
 // =======================
 // Static file handler
 // =======================
-bool HttpServer::serveStaticFile(Response& res, const std::string& path) {
-    std::string fullPath = "www" + path;
-    if (path == "/") fullPath = "www/index.html";
+bool HttpServer::serveStaticFile(Response& res, std::string_view path) {
+    std::string fullPath = staticPath(path);
 
-    std::ifstream f(fullPath, std::ios::binary);
-    if (!f.good()) return false;
-
-    std::ostringstream ss;
-    ss << f.rdbuf();
-    res.body = ss.str();
+    if (!loadFile(res, fullPath, (std::size_t)options.zeroCopyMinBytes)) return false;
 
     res.statusCode = 200;
     res.statusText = "OK";
 
     // MIME types
-    if (endsWith(fullPath, ".html"))
-        res.headers["Content-Type"] = "text/html";
-    else if (endsWith(fullPath, ".css"))
-        res.headers["Content-Type"] = "text/css";
-    else if (endsWith(fullPath, ".js"))
-        res.headers["Content-Type"] = "application/javascript";
-    else if (endsWith(fullPath, ".png"))
-        res.headers["Content-Type"] = "image/png";
-    else if (endsWith(fullPath, ".jpg") || endsWith(fullPath, ".jpeg"))
-        res.headers["Content-Type"] = "image/jpeg";
-    else
-        res.headers["Content-Type"] = "application/octet-stream";
+    res.headers["Content-Type"] = StaticCache::mimeType(fullPath);
 
     return true;
 }
 
-// =======================
-// 4 handler method
-// =======================
-static std::string mapToFilePath(const std::string& httpPath) {
-    const std::string prefix = "/api/file/";
+bool HttpServer::sendCachedStatic(Connection& conn, const Request& req, bool keepAlive,
+                                  bool& sentOk) {
+    if (!staticCache || !isCanonicalPath(req.path())) return false;
 
-    if (httpPath.rfind(prefix, 0) != 0) {
-        return "";
-    }
+    auto asset = staticCache->get(staticPath(req.path()));
+    if (!asset) return false;
 
-    std::string name = httpPath.substr(prefix.size());
+    // head dựng sẵn + header Connection + body: 4 đoạn gửi 1 lần, không ghép thành string
+    std::string_view connLine = keepAlive ? std::string_view(keepAliveHeaderLines) : Response::CLOSE_HEADER;
+    iovec iov[4] = {
+        {const_cast<char*>(asset->head.data()), asset->head.size()},
+        {const_cast<char*>(connLine.data()), connLine.size()},
+        {const_cast<char*>("\r\n"), 2},
+        {const_cast<char*>(asset->body.data()), asset->body.size()},
+    };
 
-    // Chặn ../ để tránh ghi lung tung
-    if (name.find("..") != std::string::npos || name.find('\\') != std::string::npos) {
-        return "";
-    }
-
-    return "www/files/" + name;
+    sentOk = SslIO::sendv(conn, iov, 4);
+    return true;
 }
 
+// =======================
+// 4 handler method
+// =======================
 void HttpServer::handleGET(Response& res, const Request& req) {
-    std::string filePath = mapToFilePath(req.path);
+    std::string filePath = mapToFilePath(req.path());
 
     // Nếu là file API -> đọc file thật
     if (!filePath.empty()) {
         if (!std::filesystem::exists(filePath)) {
             res.statusCode = 404;
             res.statusText = "Not Found";
-            res.body = "File not found: " + req.path;
+            res.body = "File not found: " + std::string(req.path());
             return;
         }
 
-        std::ifstream f(filePath, std::ios::binary);
-        if (!f) {
-            res.statusCode = 500;
-            res.statusText = "Internal Server Error";
-            res.body = "Cannot open file";
-            return;
-        }
+        serveFileApi(res, req, filePath);
+        return;
+    }
 
-        std::ostringstream ss;
-        ss << f.rdbuf();
-        f.close();
+    // Fallback: hành vi cũ
+    res.statusCode = 200;
+    res.statusText = "OK";
+    res.body = "GET " + std::string(req.path());
+}
 
+// GET /api/file/<name>: hỗ trợ Range / If-Range (206, multi-range, 416).
+// Đoạn được yêu cầu gửi thẳng từ file (kTLS sendfile / mmap chỉ phần cần), không buffer cả file
+void HttpServer::serveFileApi(Response& res, const Request& req, const std::string& filePath) {
+    struct stat st {};
+    int fd = openRegular(filePath, st);
+    if (fd < 0) {
+        res.statusCode = 500;
+        res.statusText = "Internal Server Error";
+        res.body = "Cannot open file";
+        return;
+    }
+
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    std::string etag = HttpRange::makeETag(size, st.st_mtim);
+
+    res.headers["Content-Type"] = "text/plain";
+    res.headers["Accept-Ranges"] = "bytes";
+    res.headers["ETag"] = etag;
+    res.headers["Last-Modified"] = HttpRange::formatHttpDate(st.st_mtime);
+
+    // If-Range không khớp (file đã đổi) -> bỏ qua Range, trả cả file
+    std::string_view range = req.header("Range");
+    std::string_view ifRange = req.header("If-Range");
+    if (!range.empty() && !ifRange.empty() &&
+        !HttpRange::ifRangeMatches(ifRange, etag, st.st_mtime)) {
+        range = std::string_view();
+    }
+
+    std::vector<HttpRange::ByteRange> ranges;
+    HttpRange::Result r =
+        !range.empty() ? HttpRange::parse(range, size, ranges) : HttpRange::Result::Ignore;
+
+    if (r == HttpRange::Result::Ignore) {
+        loadOpenFile(res, fd, size, (std::size_t)options.zeroCopyMinBytes);
         res.statusCode = 200;
         res.statusText = "OK";
-        res.headers["Content-Type"] = "text/plain";
-        res.body = ss.str();
         return;
     }
 
-    // Fallback: hành vi cũ
-    res.statusCode = 200;
-    res.statusText = "OK";
-    res.body = "GET " + req.path;
+    if (r == HttpRange::Result::Unsatisfiable) {
+        ::close(fd);
+        res.statusCode = 416;
+        res.statusText = "Range Not Satisfiable";
+        res.headers["Content-Range"] = "bytes */" + std::to_string(size);
+        return;
+    }
+
+    res.statusCode = 206;
+    res.statusText = "Partial Content";
+
+    auto body = std::make_shared<FileBody>(fd, 0, 0);
+    if (ranges.size() == 1) {
+        body->offset = ranges[0].offset;
+        body->length = ranges[0].length;
+        res.headers["Content-Range"] = HttpRange::contentRange(ranges[0], size);
+    } else {
+        static std::atomic<unsigned> boundarySeq{0};
+        char boundary[48];
+        snprintf(boundary, sizeof(boundary), "byteranges_%08x%08x", boundarySeq.fetch_add(1),
+                 (unsigned)size);
+
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            FileBody::Part part;
+            part.head = std::string(i ? "\r\n--" : "--") + boundary +
+                        "\r\nContent-Type: text/plain\r\nContent-Range: " +
+                        HttpRange::contentRange(ranges[i], size) + "\r\n\r\n";
+            part.offset = ranges[i].offset;
+            part.length = ranges[i].length;
+            body->parts.push_back(std::move(part));
+        }
+        body->trailer = std::string("\r\n--") + boundary + "--\r\n";
+        res.headers["Content-Type"] = std::string("multipart/byteranges; boundary=") + boundary;
+    }
+    res.file = std::move(body);
+}
+
+// Body upload: đã stream xuống file tạm -> rename atomic. Body trong RAM cũng qua file tạm + rename:
+// không bao giờ ghi đè tại chỗ (truncate) file mà sendfile/mmap của request khác có thể đang đọc
+// (mmap vùng đã bị cắt -> SIGBUS)
+static bool writeUploadedFile(const Request& req, const std::string& path) {
+    if (req.upload) return req.upload->commit();
+
+    auto file = UploadFile::create(path);
+    if (!file) return false;
+    if (!file->append(req.body().data(), req.body().size())) return false;
+    return file->commit();
 }
 
 void HttpServer::handlePOST(Response& res, const Request& req) {
-    std::string filePath = mapToFilePath(req.path);
+    std::string filePath = mapToFilePath(req.path());
 
     // Nếu là file API -> tạo file thật
     if (!filePath.empty()) {
-        std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
-
-        std::ofstream f(filePath, std::ios::binary);
-        if (!f) {
+        if (!writeUploadedFile(req, filePath)) {
             res.statusCode = 500;
             res.statusText = "Internal Server Error";
             res.body = "Cannot write file";
             return;
         }
 
-        f << req.body;
-        f.close();
-
         res.statusCode = 201;
         res.statusText = "Created";
-        res.body = "File created: " + req.path;
+        res.body = "File created: " + std::string(req.path());
         return;
     }
 
@@ -493,11 +728,11 @@ void HttpServer::handlePOST(Response& res, const Request& req) {
     res.statusCode = 200;
     res.statusText = "OK";
     res.headers["Content-Type"] = "application/json";
-    res.body = "{ \"received\": \"" + req.body + "\" }";
+    res.body = "{ \"received\": \"" + std::string(req.body()) + "\" }";
 }
 
 void HttpServer::handlePUT(Response& res, const Request& req) {
-    std::string path = mapToFilePath(req.path);
+    std::string path = mapToFilePath(req.path());
 
     if (path.empty()) {
         res.statusCode = 400;
@@ -506,27 +741,20 @@ void HttpServer::handlePUT(Response& res, const Request& req) {
         return;
     }
 
-    // Tạo thư mục nếu chưa tồn tại
-    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
-
-    std::ofstream f(path, std::ios::binary);
-    if (!f) {
+    if (!writeUploadedFile(req, path)) {
         res.statusCode = 500;
         res.statusText = "Internal Server Error";
         res.body = "Cannot write file";
         return;
     }
 
-    f << req.body;
-    f.close();
-
     res.statusCode = 201;
     res.statusText = "Created";
-    res.body = "File saved to " + req.path;
+    res.body = "File saved to " + std::string(req.path());
 }
 
 void HttpServer::handleDELETE(Response& res, const Request& req) {
-    std::string path = mapToFilePath(req.path);
+    std::string path = mapToFilePath(req.path());
 
     if (path.empty()) {
         res.statusCode = 400;
@@ -539,37 +767,364 @@ void HttpServer::handleDELETE(Response& res, const Request& req) {
         std::filesystem::remove(path);
         res.statusCode = 200;
         res.statusText = "OK";
-        res.body = "Deleted " + req.path;
+        res.body = "Deleted " + std::string(req.path());
     } else {
         res.statusCode = 404;
         res.statusText = "Not Found";
-        res.body = "File not found: " + req.path;
+        res.body = "File not found: " + std::string(req.path());
+    }
+}
+
+// =======================
+// /api/stats
+// =======================
+void HttpServer::handleStats(Response& res) {
+    nlohmann::json j;
+
+    if (tlsCache) {
+        TlsSessionCache::Stats t = tlsCache->stats();
+        j["tls"] = {
+            {"session_cache_hits", t.cacheHits},
+            {"session_cache_misses", t.cacheMisses},
+            {"session_cache_stored", t.cacheStored},
+            {"session_cache_evicted", t.cacheEvicted},
+            {"session_cache_size", t.sessions},
+            {"ticket_issued", t.ticketIssued},
+            {"ticket_hits", t.ticketHits},
+            {"ticket_misses", t.ticketMisses},
+            {"ticket_key_rotations", t.keyRotations},
+        };
+    }
+
+    if (staticCache) {
+        StaticCache::Stats c = staticCache->stats();
+        j["static_cache"] = {
+            {"hits", c.hits},
+            {"misses", c.misses},
+            {"evictions", c.evictions},
+            {"invalidations", c.invalidations},
+            {"entries", c.entries},
+            {"bytes", c.bytes},
+            {"capacity", c.capacity},
+        };
+    }
+
+    if (handshakePool) {
+        HandshakePool::Stats h = handshakePool->stats();
+        j["handshake"] = {
+            {"threads", h.threads},
+            {"queue_depth", h.queueDepth},
+            {"peak_queue_depth", h.peakQueueDepth},
+            {"completed", h.completed},
+            {"failed", h.failed},
+            {"timed_out", h.timedOut},
+            {"avg_ms", h.avgMs},
+            {"max_ms", h.maxMs},
+        };
+    }
+
+    if (threadPool && threadPool->workStealing()) {
+        ThreadPool::StealStats s = threadPool->stealStats();
+        j["work_stealing"] = {
+            {"workers", s.workers},
+            {"executed", s.executed},
+            {"stolen", s.stolen},
+        };
+    }
+
+    if (logger) {
+        Logger::Stats s = logger->stats();
+        j["logger"] = {
+            {"written", s.written},
+            {"dropped", s.dropped},
+            {"rings", s.rings},
+            {"flush_ms", options.logFlushMs},
+            {"format", options.logBinary ? "binary" : "csv"},
+        };
+    }
+
+    {
+        SystemMetrics::Snapshot s = SystemMetrics::snapshot();
+        j["cpu"] = {
+            {"usage", s.cpu},
+            {"os", s.osCpu},
+            {"busy", s.busyPercent},
+            {"cores", s.cpuLimit},
+            {"source", s.cgroup ? "cgroup" : "proc_stat"},
+            {"period_ms", s.periodMs},
+        };
+    }
+
+    j["overload_rejected"] = overloadRejected.load(std::memory_order_relaxed);
+
+    {
+        Tracer::Stats s = Tracer::instance().stats();
+        j["trace"] = {
+            {"enabled", s.enabled},
+            {"recorded", s.recorded},
+            {"overwritten", s.overwritten},
+            {"threads", s.threads},
+            {"events_per_thread", s.eventsPerThread},
+        };
     }
+
+    // Adaptive: số lần đổi thuật toán + chi phí đổi (cộng dồn mọi scheduler adaptive)
+    std::vector<const Scheduler*> scheds;
+    if (threadPool) scheds = threadPool->schedulers();
+    for (const auto& sh : shards) {
+        if (!sh->ownThreadPool) continue;
+        auto more = sh->ownThreadPool->schedulers();
+        scheds.insert(scheds.end(), more.begin(), more.end());
+    }
+
+    AdaptiveScheduler::SwitchStats sw;
+    std::size_t adaptiveCount = 0;
+    const AIPredictor* predictor = nullptr;
+    const TreeModel* model = nullptr;
+    for (const Scheduler* sc : scheds) {
+        auto* ad = dynamic_cast<const AdaptiveScheduler*>(sc);
+        if (!ad) continue;
+        AdaptiveScheduler::SwitchStats s = ad->switchStats();
+        ++adaptiveCount;
+        if (!predictor) predictor = ad->predictor();
+        if (!model) model = ad->model();
+        sw.switches += s.switches;
+        sw.stalePops += s.stalePops;
+        sw.stalePopsSinceSwitch += s.stalePopsSinceSwitch;
+        sw.compactions += s.compactions;
+        sw.compactionNs += s.compactionNs;
+        sw.compactionNsSinceSwitch += s.compactionNsSinceSwitch;
+        sw.pending += s.pending;
+    }
+    if (adaptiveCount > 0) {
+        j["adaptive"] = {
+            {"schedulers", adaptiveCount},
+            {"switches", sw.switches},
+            {"stale_pops", sw.stalePops},
+            {"stale_pops_since_switch", sw.stalePopsSinceSwitch},
+            {"compactions", sw.compactions},
+            {"compaction_ns", sw.compactionNs},
+            {"compaction_ns_since_switch", sw.compactionNsSinceSwitch},
+            {"pending", sw.pending},
+        };
+    }
+    if (model && model->loaded()) {
+        j["ai"] = {
+            {"mode", "embedded"},
+            {"trees", model->treeCount()},
+            {"nodes", model->nodeCount()},
+        };
+    } else if (predictor) {
+        AIPredictor::Stats s = predictor->stats();
+        j["ai"] = {
+            {"mode", "remote"},
+            {"posted", s.posted},
+            {"dropped", s.dropped},
+            {"predictions", s.predictions},
+            {"failures", s.failures},
+            {"last_latency_us", s.lastLatencyUs},
+            {"recommended", s.recommended >= 0 ? schedAlgoName((SchedAlgo)s.recommended) : "none"},
+        };
+    }
+
+    res.statusCode = 200;
+    res.statusText = "OK";
+    res.headers["Content-Type"] = "application/json";
+    res.body = j.dump();
+}
+
+// =======================
+// /api/logs (chunked)
+// =======================
+bool HttpServer::streamLogs(Connection& conn, const Request& req, Response& res, int fd,
+                            bool& keepAlive) {
+    if (logger) logger->flush();
+
+    // HTTP/1.0 không hiểu chunked -> ChunkedWriter gửi thẳng rồi đóng connection
+    ChunkedWriter out(conn, req.version() != "HTTP/1.0");
+    keepAlive = keepAlive && out.keepAliveAllowed();
+
+    res.statusCode = 200;
+    res.statusText = "OK";
+    res.headers["Content-Type"] = "text/csv";
+    if (!out.begin(res)) return false;
+
+    // Byte đầu tiên tới client ngay khi đọc xong block đầu, không chờ cả file
+    char buf[64 * 1024];
+    off_t off = 0;
+    while (true) {
+        ssize_t n = pread(fd, buf, sizeof(buf), off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        if (!out.write(buf, (std::size_t)n)) return false;
+        off += n;
+    }
+    return out.finish();
+}
+
+// =======================
+// /metrics (Prometheus)
+// =======================
+void HttpServer::handleMetrics(Response& res) {
+    std::string out = metrics ? metrics->render() : std::string();
+
+    out += "# HELP http_latency_ewma_ms EWMA of request latency (enqueue to response).\n"
+           "# TYPE http_latency_ewma_ms gauge\n";
+    out += "http_latency_ewma_ms " + std::to_string(latencyAvg.load(std::memory_order_relaxed)) + "\n";
+
+    std::size_t pending = threadPool ? threadPool->getPendingTaskCount() : 0;
+    for (const auto& sh : shards) {
+        if (sh->ownThreadPool) pending += sh->ownThreadPool->getPendingTaskCount();
+    }
+    out += "# HELP http_pending_tasks Tasks queued or running in worker pools.\n"
+           "# TYPE http_pending_tasks gauge\n";
+    out += "http_pending_tasks " + std::to_string(pending) + "\n";
+
+    out += "# HELP http_overload_rejected_total Requests answered 503 because the worker queue was full.\n"
+           "# TYPE http_overload_rejected_total counter\n";
+    out += "http_overload_rejected_total " +
+           std::to_string(overloadRejected.load(std::memory_order_relaxed)) + "\n";
+
+    if (logger) {
+        Logger::Stats s = logger->stats();
+        out += "# HELP http_log_dropped_total Log records dropped because a ring was full.\n"
+               "# TYPE http_log_dropped_total counter\n";
+        out += "http_log_dropped_total " + std::to_string(s.dropped) + "\n";
+    }
+
+    res.statusCode = 200;
+    res.statusText = "OK";
+    res.headers["Content-Type"] = "text/plain; version=0.0.4";
+    res.body = std::move(out);
+}
+
+void HttpServer::handleTrace(Response& res) {
+    if (!Tracer::enabled()) {
+        res.statusCode = 404;
+        res.statusText = "Not Found";
+        res.body = "Tracing disabled (trace_enabled in config/server.json)";
+        return;
+    }
+
+    res.statusCode = 200;
+    res.statusText = "OK";
+    res.headers["Content-Type"] = "application/json";
+    res.body = Tracer::instance().dumpJson();
+}
+
+// Log nhị phân: đổi từng segment (mmap) sang CSV rồi gửi theo chunk
+bool HttpServer::streamLogSegments(Connection& conn, const Request& req, Response& res,
+                                   const std::vector<std::string>& segments, bool& keepAlive) {
+    ChunkedWriter out(conn, req.version() != "HTTP/1.0");
+    keepAlive = keepAlive && out.keepAliveAllowed();
+
+    res.statusCode = 200;
+    res.statusText = "OK";
+    res.headers["Content-Type"] = "text/csv";
+    if (!out.begin(res)) return false;
+
+    std::string buf = LogSegment::CSV_HEADER;
+    buf.reserve(64 * 1024 + 256);
+    for (const auto& path : segments) {
+        LogSegment::Reader seg;
+        if (!seg.open(path)) continue;
+        for (std::size_t i = 0; i < seg.size(); ++i) {
+            seg.appendCsv(buf, i);
+            if (buf.size() >= 64 * 1024) {
+                if (!out.write(buf.data(), buf.size())) return false;
+                buf.clear();
+            }
+        }
+    }
+    if (!buf.empty() && !out.write(buf.data(), buf.size())) return false;
+    return out.finish();
 }
 
 // =======================
 // handleClient
 // =======================
-void HttpServer::handleClient(SSL* ssl, int clientSocketFd, const Request& req) {
-    // std::cout << "[DEBUG] handleClient START, path=[" << req.path << "]\n";
+bool HttpServer::handleClient(Connection& conn, const Request& req, RequestTimeline& tl) {
+    // std::cout << "[DEBUG] handleClient START, path=[" << req.path() << "]\n";
+
+    // Keep-alive: tôn trọng header Connection + giới hạn số request/connection
+    bool keepAlive = isRunning && wantsKeepAlive(req) &&
+                     conn.requestsServed + 1 < options.maxRequestsPerConn;
 
     Response res;
     res.headers["Content-Type"] = "text/plain";
-    res.headers["Connection"] = "close";
+    // Header Connection/Keep-Alive dựng sẵn trong constructor (như sendCachedStatic)
+    res.connectionHeaders = keepAlive ? std::string_view(keepAliveHeaderLines) : Response::CLOSE_HEADER;
 
     bool handled = false;
 
     // 1) favicon
-    if (req.path == "/favicon.ico") {
+    if (req.path() == "/favicon.ico") {
         res.statusCode = 404;
         res.statusText = "Not Found";
         res.body = "";
         handled = true;
     }
 
-    // 2) Static file (GET only)
-    if (!handled && req.method == "GET") {
-        if (serveStaticFile(res, req.path)) {
+    // 1b) Thống kê nội bộ (không chạy workload giả lập)
+    if (!handled && req.method() == "GET" && req.path() == "/api/stats") {
+        handleStats(res);
+        handled = true;
+    }
+    if (!handled && req.method() == "GET" && req.path() == "/metrics") {
+        handleMetrics(res);
+        handled = true;
+    }
+    if (!handled && req.method() == "GET" && req.path() == "/api/trace") {
+        handleTrace(res);
+        handled = true;
+    }
+
+    // 1c) Log CSV: stream theo chunk trong lúc đọc file, không dựng cả body trong RAM
+    if (!handled && req.method() == "GET" && req.path() == "/api/logs" && options.logBinary) {
+        if (logger) logger->flush();
+        auto segments = LogSegment::listSegments(LOG_SEGMENT_PREFIX);
+        if (!segments.empty()) {
+            // Stream: dựng và ghi đan xen nhau -> tính hết vào write
+            tl.handlerDone = std::chrono::steady_clock::now();
+            if (!streamLogSegments(conn, req, res, segments, keepAlive)) return false;
+            conn.lastStatus = res.statusCode;
+            conn.requestsServed++;
+            return keepAlive;
+        }
+        res.statusCode = 404;
+        res.statusText = "Not Found";
+        res.body = "No log yet";
+        handled = true;
+    }
+    if (!handled && req.method() == "GET" && req.path() == "/api/logs") {
+        int fd = ::open(LOG_PATH, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            tl.handlerDone = std::chrono::steady_clock::now();
+            bool ok = streamLogs(conn, req, res, fd, keepAlive);
+            ::close(fd);
+            if (!ok) return false;
+            conn.lastStatus = res.statusCode;
+            conn.requestsServed++;
+            return keepAlive;
+        }
+        res.statusCode = 404;
+        res.statusText = "Not Found";
+        res.body = "No log yet";
+        handled = true;
+    }
+
+    // 2) Static file (GET only): cache hit -> gửi luôn response dựng sẵn
+    if (!handled && req.method() == "GET") {
+        bool sentOk = false;
+        tl.handlerDone = std::chrono::steady_clock::now();
+        if (sendCachedStatic(conn, req, keepAlive, sentOk)) {
+            if (!sentOk) return false;
+            conn.lastStatus = 200;
+            conn.requestsServed++;
+            return keepAlive;
+        }
+
+        if (serveStaticFile(res, req.path())) {
             handled = true;
         }
     }
@@ -578,17 +1133,13 @@ void HttpServer::handleClient(SSL* ssl, int clientSocketFd, const Request& req)
     if (!handled) {
         // ===== SMART WORKLOAD ENGINE =====
         static double loadFactor = 20000.0;
-        int w = std::max(1, (int)req.path.size());
+        int w = std::max(1, (int)req.path().size());
         volatile long dummy = 0;
         long iterations = (long)(w * loadFactor);
 
-        auto t0 = std::chrono::steady_clock::now();
         for (long i = 0; i < iterations; ++i) dummy += i;
-        auto t1 = std::chrono::steady_clock::now();
-
-        double busySec = std::chrono::duration<double>(t1 - t0).count();
-        SystemMetrics::addBusy(busySec);
 
+        // busy-time: worker lambda cộng CPU time của thread (CLOCK_THREAD_CPUTIME_ID)
         double cpu = SystemMetrics::getCpuUsage();
         if (cpu < 30.0)
             loadFactor *= 1.10;
@@ -598,13 +1149,13 @@ void HttpServer::handleClient(SSL* ssl, int clientSocketFd, const Request& req)
         loadFactor = std::clamp(loadFactor, 5000.0, 200000.0);
 
         // ===== ROUTER =====
-        if (req.method == "GET") {
+        if (req.method() == "GET") {
             handleGET(res, req);
-        } else if (req.method == "POST") {
+        } else if (req.method() == "POST") {
             handlePOST(res, req);
-        } else if (req.method == "PUT") {
+        } else if (req.method() == "PUT") {
             handlePUT(res, req);
-        } else if (req.method == "DELETE") {
+        } else if (req.method() == "DELETE") {
             handleDELETE(res, req);
         } else {
             res.statusCode = 405;
@@ -614,13 +1165,12 @@ void HttpServer::handleClient(SSL* ssl, int clientSocketFd, const Request& req)
     }
 
     // 4) ALWAYS send response here (1 lần duy nhất)
-    std::string raw = res.build();
-    sendAllSSL(ssl, raw.c_str(), raw.size());
-
-    SSL_shutdown(ssl);   // gửi close_notify
-    SSL_shutdown(ssl);   // chờ close_notify từ client
+    // status line + header + body là các iovec riêng, body không bị copy
+    tl.handlerDone = std::chrono::steady_clock::now();
+    if (!SslIO::sendResponse(conn, res)) return false;
 
-    SSL_free(ssl);
-    close(clientSocketFd);
+    conn.lastStatus = res.statusCode;
+    conn.requestsServed++;
+    return keepAlive;
 
 }
\ No newline at end of file
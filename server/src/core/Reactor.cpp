@@ -0,0 +1,603 @@
+#include "core/Reactor.hpp"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "core/HttpParser.hpp"
+#include "core/Socket.hpp"
+#include "core/SslIO.hpp"
+#include "core/UploadFile.hpp"
+#include "monitor/Tracer.hpp"
+#include "tls/HandshakePool.hpp"
+
+// OpenSSL
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+// =======================
+//  Giới hạn
+// =======================
+static constexpr std::size_t MAX_HEADER_BYTES = 65536;  // guard header quá lớn
+static constexpr int         MAX_EVENTS       = 256;
+
+Reactor::Reactor(SSL_CTX* sslCtx, const ServerOptions& options, RequestCallback onRequest)
+    : sslCtx(sslCtx), options(options), onRequest(std::move(onRequest)) {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        std::cerr << "[REACTOR] epoll_create1 failed, errno=" << errno << "\n";
+    }
+
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd >= 0 && epollFd >= 0) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = wakeFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+    }
+}
+
+Reactor::~Reactor() {
+    conns.clear();
+    resumed.clear();
+    if (listenSocket) listenSocket->closeSocket();
+    if (wakeFd >= 0) ::close(wakeFd);
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+bool Reactor::listen(int port) {
+    if (epollFd < 0) return false;
+
+    listenSocket = std::make_unique<Socket>();
+    if (!listenSocket->bind(port)) {
+        std::cerr << "[ERROR] Cannot bind port " << port << "\n";
+        return false;
+    }
+    if (!listenSocket->listen()) {
+        std::cerr << "[ERROR] Listen failed\n";
+        return false;
+    }
+    if (!listenSocket->setNonBlocking()) {
+        std::cerr << "[ERROR] Cannot set listening socket non-blocking\n";
+        return false;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenSocket->fd();
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, listenSocket->fd(), &ev) == 0;
+}
+
+void Reactor::stop() {
+    running.store(false);
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t n = ::write(wakeFd, &one, sizeof(one));
+        (void)n;
+    }
+}
+
+void Reactor::resume(std::shared_ptr<Connection> conn) {
+    {
+        std::lock_guard<std::mutex> lock(resumeMtx);
+        if (!running.load()) {
+            conn->close();
+            return;
+        }
+        resumed.push_back(std::move(conn));
+    }
+
+    uint64_t one = 1;
+    ssize_t n = ::write(wakeFd, &one, sizeof(one));
+    (void)n;
+}
+
+void Reactor::drainResumed() {
+    std::vector<std::shared_ptr<Connection>> batch;
+    {
+        std::lock_guard<std::mutex> lock(resumeMtx);
+        batch.swap(resumed);
+    }
+
+    for (auto& conn : batch) {
+        if (conn->fd < 0) continue;
+
+        conn->state = Connection::State::Reading;
+        conn->touch();
+        conns[conn->fd] = conn;
+        watch(*conn, EPOLLIN, true);
+
+        // Pipelining: request kế tiếp có thể đã nằm sẵn trong buffer
+        int st = checkComplete(*conn);
+        if (st < 0) {
+            closeConnection(conn->fd);
+        } else if (st > 0) {
+            dispatch(conn);
+        } else if (!driveRead(conn)) {
+            // SSL có thể còn giữ dữ liệu đã giải mã -> đọc luôn
+            closeConnection(conn->fd);
+        }
+    }
+}
+
+// =======================
+//  Event loop
+// =======================
+void Reactor::run() {
+    running.store(true);
+
+    epoll_event events[MAX_EVENTS];
+    auto lastSweep = std::chrono::steady_clock::now();
+
+    while (running.load()) {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[REACTOR] epoll_wait failed, errno=" << errno << "\n";
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == wakeFd) {
+                uint64_t v;
+                while (::read(wakeFd, &v, sizeof(v)) > 0) {}
+                drainResumed();
+                continue;
+            }
+            if (listenSocket && fd == listenSocket->fd()) {
+                onAccept();
+                continue;
+            }
+
+            auto it = conns.find(fd);
+            if (it == conns.end()) continue;
+
+            // copy shared_ptr: connection có thể bị xóa khỏi map trong lúc xử lý
+            std::shared_ptr<Connection> conn = it->second;
+            onClientEvent(conn, events[i].events);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep >= std::chrono::seconds(1)) {
+            sweepIdle();
+            lastSweep = now;
+        }
+    }
+
+    conns.clear();
+
+    std::lock_guard<std::mutex> lock(resumeMtx);
+    resumed.clear();
+}
+
+void Reactor::onAccept() {
+    while (true) {
+        int clientFd = listenSocket->acceptClient();
+        if (clientFd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "[WARN] accept() failed, errno=" << errno << "\n";
+            }
+            return;
+        }
+
+        Tracer::instant("net", "accept", {"fd", clientFd});
+
+        // Tắt Nagle cho client để giảm latency
+        int flag = 1;
+        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+        // Không TLS: đọc request ngay
+        if (!sslCtx) {
+            auto conn = std::make_shared<Connection>(clientFd, nullptr);
+            conn->state = Connection::State::Reading;
+            conns[clientFd] = conn;
+            watch(*conn, EPOLLIN, true);
+            continue;
+        }
+
+        // Tạo SSL object cho client
+        SSL* ssl = SSL_new(sslCtx);
+        if (!ssl) {
+            std::cerr << "[SSL] SSL_new failed\n";
+            ::close(clientFd);
+            continue;
+        }
+        SSL_set_fd(ssl, clientFd);
+        SSL_set_accept_state(ssl);
+
+        auto conn = std::make_shared<Connection>(clientFd, ssl);
+
+        // Handshake (tốn CPU) giao cho pool riêng, xong sẽ quay lại qua resume()
+        if (handshakePool) {
+            handshakePool->submit(std::move(conn), this);
+            continue;
+        }
+
+        conns[clientFd] = conn;
+        watch(*conn, EPOLLIN, true);
+    }
+}
+
+void Reactor::onClientEvent(const std::shared_ptr<Connection>& conn, uint32_t events) {
+    if (events & EPOLLERR) {
+        closeConnection(conn->fd);
+        return;
+    }
+
+    // Đang gửi nốt response của reactor (503) rồi đóng
+    if (conn->closeAfterOut) {
+        uint32_t wait = 0;
+        if (!flushOut(*conn, wait) || wait == 0) {
+            closeConnection(conn->fd);
+        } else {
+            watch(*conn, wait, false);
+        }
+        return;
+    }
+
+    if (conn->state == Connection::State::Handshake) {
+        if (!driveHandshake(*conn)) {
+            closeConnection(conn->fd);
+            return;
+        }
+        if (conn->state == Connection::State::Handshake) return;
+    }
+
+    if (conn->state == Connection::State::Reading) {
+        if (!driveRead(conn)) {
+            closeConnection(conn->fd);
+        }
+    }
+}
+
+// =======================
+//  SSL handshake (non-blocking)
+// =======================
+bool Reactor::driveHandshake(Connection& conn) {
+    int ret = SSL_accept(conn.ssl);
+    if (ret == 1) {
+        conn.state = Connection::State::Reading;
+        conn.touch();
+        conn.handshakeDoneAt = conn.lastActive;
+        Tracer::complete("net", "tls_handshake", conn.acceptedAt, conn.handshakeDoneAt, {"fd", conn.fd});
+        watch(conn, EPOLLIN, false);
+        return true;
+    }
+
+    int err = SSL_get_error(conn.ssl, ret);
+    if (err == SSL_ERROR_WANT_READ) {
+        watch(conn, EPOLLIN, false);
+        return true;
+    }
+    if (err == SSL_ERROR_WANT_WRITE) {
+        watch(conn, EPOLLOUT, false);
+        return true;
+    }
+
+    std::cerr << "[SSL] SSL_accept failed\n";
+    ERR_print_errors_fp(stderr);
+    return false;
+}
+
+// =======================
+//  Đọc request (non-blocking)
+// =======================
+bool Reactor::driveRead(const std::shared_ptr<Connection>& conn) {
+    char buffer[16384];
+
+    // Gửi nốt phần interim response (100 Continue) còn trong outBuf, không chờ
+    uint32_t outWait = 0;
+    if (!flushOut(*conn, outWait)) return false;
+
+    while (true) {
+        int n = conn->ssl ? SSL_read(conn->ssl, buffer, sizeof(buffer))
+                          : (int)::read(conn->fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            conn->touch();
+            if (conn->inBuf.empty() && conn->headerEnd == 0) conn->requestStartAt = conn->lastActive;
+            conn->inBuf.append(buffer, n);
+
+            int st = checkComplete(*conn);
+            if (st < 0) return false;
+            if (st > 0) {
+                dispatch(conn);
+                return true;
+            }
+            if (conn->upload && pauseUpload(conn)) return true;
+            continue;
+        }
+
+        if (!conn->ssl) {
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                watch(*conn, EPOLLIN | (conn->outBuf.empty() ? 0 : EPOLLOUT), false);
+                return true;
+            }
+            return false;  // 0 = client đóng
+        }
+
+        int err = SSL_get_error(conn->ssl, n);
+        if (err == SSL_ERROR_WANT_READ) {
+            watch(*conn, EPOLLIN | (conn->outBuf.empty() ? 0 : EPOLLOUT), false);
+            return true;
+        }
+        if (err == SSL_ERROR_WANT_WRITE) {
+            watch(*conn, EPOLLOUT, false);
+            return true;
+        }
+        // ZERO_RETURN / SYSCALL / SSL -> client đóng hoặc lỗi
+        return false;
+    }
+}
+
+int Reactor::checkComplete(Connection& conn) {
+    // 1) parse tiếp phần mới đọc đến khi đủ header
+    if (conn.headerEnd == 0) {
+        HttpParser::Status st = conn.parser.feed(conn.inBuf);
+        if (st == HttpParser::Status::Error) return -1;
+        if (st == HttpParser::Status::Incomplete) {
+            return conn.inBuf.size() > MAX_HEADER_BYTES ? -1 : 0;
+        }
+
+        conn.headerEnd = conn.parser.headerEnd();
+
+        // 2) Content-Length (cap theo upload, body RAM kiểm tra trong beginBody)
+        //    hoặc chunked (độ dài chưa biết, cap kiểm tra lúc giải mã)
+        conn.chunked = conn.parser.chunked();
+        conn.contentLength = conn.chunked ? 0 : conn.parser.contentLength();
+        if (conn.contentLength > std::max(options.maxBodyBytes, options.maxUploadBytes)) return -1;
+        if ((conn.chunked || conn.contentLength > 0) && !beginBody(conn)) return -1;
+
+        if (conn.chunked) {
+            conn.chunkDecoder.reset();
+            conn.bodyReceived = 0;
+            conn.bodyRawPos = conn.headerEnd;
+        }
+    }
+
+    if (conn.chunked) return readChunked(conn);
+
+    // 3a) upload: chuyển phần body vừa đọc sang backlog của file tạm (IO thread ghi đĩa),
+    //     inBuf chỉ còn header (và request pipelined phía sau nếu có).
+    //     Mỗi lần chỉ copy phần vừa đọc (<= 1 buffer driveRead), không write(2) trên reactor
+    if (conn.upload) {
+        std::size_t avail = conn.inBuf.size() - conn.headerEnd;
+        std::size_t take = std::min<std::size_t>(avail, conn.contentLength - conn.bodyReceived);
+        if (take > 0) {
+            if (!conn.upload->append(conn.inBuf.data() + conn.headerEnd, take)) {
+                std::cerr << "[UPLOAD] aborting upload to " << conn.upload->target() << "\n";
+                return -1;
+            }
+            conn.inBuf.erase(conn.headerEnd, take);
+            conn.bodyReceived += (long long)take;
+        }
+        return conn.bodyReceived == conn.contentLength ? 1 : 0;
+    }
+
+    // 3b) đủ body chưa
+    return conn.inBuf.size() >= conn.headerEnd + (std::size_t)conn.contentLength ? 1 : 0;
+}
+
+int Reactor::readChunked(Connection& conn) {
+    const long long limit = conn.upload ? options.maxUploadBytes : options.maxBodyBytes;
+    // Body trong RAM: data giải mã được dồn về ngay sau header (đích luôn đứng trước nguồn)
+    char* dst = &conn.inBuf[0] + conn.headerEnd;
+    bool writeFailed = false;
+
+    std::size_t consumed = 0;
+    ChunkedDecoder::Status st = conn.chunkDecoder.feed(
+        conn.inBuf.data() + conn.bodyRawPos, conn.inBuf.size() - conn.bodyRawPos, consumed,
+        [&](const char* data, std::size_t n) {
+            if (conn.bodyReceived + (long long)n > limit) return false;
+            if (conn.upload) {
+                if (!conn.upload->append(data, n)) {
+                    writeFailed = true;
+                    return false;
+                }
+            } else {
+                std::memmove(dst + conn.bodyReceived, data, n);
+            }
+            conn.bodyReceived += (long long)n;
+            return true;
+        });
+
+    if (st == ChunkedDecoder::Status::Error) {
+        if (writeFailed) std::cerr << "[UPLOAD] aborting upload to " << conn.upload->target() << "\n";
+        return -1;
+    }
+
+    // Bỏ phần framing (và data đã xuống file) khỏi inBuf -> bộ nhớ không phình theo số chunk
+    std::size_t keep = conn.headerEnd + (conn.upload ? 0 : (std::size_t)conn.bodyReceived);
+    conn.inBuf.erase(keep, conn.bodyRawPos + consumed - keep);
+    conn.bodyRawPos = keep;
+
+    if (st != ChunkedDecoder::Status::Done) return 0;
+
+    // Từ đây giống request có Content-Length = số byte đã giải mã
+    conn.chunked = false;
+    conn.contentLength = conn.bodyReceived;
+    return 1;
+}
+
+bool Reactor::beginBody(Connection& conn) {
+    if (uploadTarget) {
+        const Request& head = conn.parser.head();
+        std::string target = uploadTarget(Request::slice(conn.inBuf, head.methodSpan),
+                                          Request::slice(conn.inBuf, head.pathSpan));
+
+        if (!target.empty()) {
+            if (conn.contentLength > options.maxUploadBytes) return false;
+
+            conn.upload = UploadFile::create(target);
+            if (!conn.upload) return false;
+            conn.bodyReceived = 0;
+
+            // Client chờ 100-continue trước khi gửi body lớn (vd curl).
+            // Qua outBuf: gửi không chờ, socket đầy thì driveRead gửi tiếp khi có EPOLLOUT
+            std::string_view expect = head.headerIn(conn.inBuf, "Expect");
+            if (expect.size() == 12 && strncasecmp(expect.data(), "100-continue", 12) == 0) {
+                static constexpr std::string_view cont = "HTTP/1.1 100 Continue\r\n\r\n";
+                conn.outBuf.append(cont.data(), cont.size());
+                uint32_t wait = 0;
+                if (!flushOut(conn, wait)) return false;
+            }
+            return true;
+        }
+    }
+
+    return conn.contentLength <= options.maxBodyBytes;
+}
+
+bool Reactor::pauseUpload(const std::shared_ptr<Connection>& conn) {
+    // Đĩa chậm hơn mạng: backlog đầy -> ngừng đọc, IO thread trả connection về qua resume()
+    // (callback chạy trên IO thread; drainResumed chạy trên reactor nên luôn sau đoạn dưới)
+    if (!conn->upload->pauseUntilDrained([this, conn] { resume(conn); })) return false;
+
+    conn->state = Connection::State::Processing;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, nullptr);
+    conn->epollEvents = 0;
+    conns.erase(conn->fd);
+    return true;
+}
+
+void Reactor::dispatch(const std::shared_ptr<Connection>& conn) {
+    // Upload: body đã nằm trong file tạm, inBuf chỉ còn header
+    std::size_t bodyLen = conn->upload ? 0 : (std::size_t)conn->contentLength;
+    std::size_t total = conn->headerEnd + bodyLen;
+
+    // Spans đã có sẵn từ parser; request chỉ cần sở hữu bytes của nó
+    Request req = conn->parser.take();
+    if (conn->inBuf.size() == total) {
+        // Không có request pipelined phía sau -> lấy luôn buffer, không copy
+        req.raw.swap(conn->inBuf);
+    } else {
+        req.raw.assign(conn->inBuf, 0, total);
+        conn->inBuf.erase(0, total);
+    }
+    req.bodySpan = {conn->headerEnd, bodyLen};
+    req.upload = std::move(conn->upload);
+
+    auto now = std::chrono::steady_clock::now();
+    req.timeline.accepted = conn->acceptedAt;
+    req.timeline.handshakeDone = conn->handshakeDoneAt;
+    req.timeline.firstByte = conn->requestStartAt;
+    req.timeline.parsed = now;
+    req.timeline.firstOnConnection = conn->requestsServed == 0;
+    if (req.timeline.firstByte != std::chrono::steady_clock::time_point{}) {
+        Tracer::complete("http", "parse", req.timeline.firstByte, now, {"fd", conn->fd},
+                         {"bytes", (std::int64_t)total});
+    }
+    // Request pipelined phía sau đã có sẵn byte
+    conn->requestStartAt = conn->inBuf.empty() ? std::chrono::steady_clock::time_point{} : now;
+
+    conn->headerEnd = 0;
+    conn->contentLength = 0;
+    conn->bodyReceived = 0;
+    conn->bodyRawPos = 0;
+
+    // Từ đây worker sở hữu fd: bỏ khỏi epoll
+    conn->state = Connection::State::Processing;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, nullptr);
+    conn->epollEvents = 0;
+    conns.erase(conn->fd);
+
+    onRequest(conn, std::move(req));
+}
+
+// =======================
+//  Helpers
+// =======================
+bool Reactor::flushOut(Connection& conn, uint32_t& waitEvents) {
+    waitEvents = 0;
+    if (conn.outBuf.empty()) return true;
+
+    std::size_t sent = 0;
+    SslIO::TrySend st = SslIO::trySend(conn, conn.outBuf.data() + conn.outPos,
+                                       conn.outBuf.size() - conn.outPos, sent);
+    conn.outPos += sent;
+    if (sent > 0) conn.touch();
+
+    switch (st) {
+    case SslIO::TrySend::Done:
+        conn.outBuf.clear();
+        conn.outPos = 0;
+        return true;
+    case SslIO::TrySend::WantWrite:
+        waitEvents = EPOLLOUT;
+        return true;
+    case SslIO::TrySend::WantRead:
+        waitEvents = EPOLLIN;
+        return true;
+    default:
+        return false;
+    }
+}
+
+void Reactor::sendAndClose(std::shared_ptr<Connection> conn, std::string_view data) {
+    if (conn->fd < 0) return;
+
+    conn->outBuf.append(data.data(), data.size());
+    conn->closeAfterOut = true;
+
+    uint32_t wait = 0;
+    if (!flushOut(*conn, wait) || wait == 0) {
+        conn->close();
+        return;
+    }
+
+    // Connection đã bỏ khỏi epoll lúc dispatch -> đăng ký lại chỉ để gửi nốt
+    conn->touch();
+    conns[conn->fd] = conn;
+    watch(*conn, wait, true);
+}
+
+void Reactor::watch(Connection& conn, uint32_t events, bool add) {
+    if (!add && conn.epollEvents == events) return;
+
+    epoll_event ev{};
+    ev.events = events | EPOLLRDHUP;
+    ev.data.fd = conn.fd;
+    epoll_ctl(epollFd, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, conn.fd, &ev);
+    conn.epollEvents = events;
+}
+
+void Reactor::closeConnection(int fd) {
+    auto it = conns.find(fd);
+    if (it == conns.end()) return;
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    it->second->close();
+    conns.erase(it);
+}
+
+void Reactor::sweepIdle() {
+    auto now = std::chrono::steady_clock::now();
+    auto ioDeadline = now - std::chrono::seconds(options.ioTimeoutSec);
+    auto idleDeadline = now - std::chrono::seconds(options.keepAliveTimeoutSec);
+
+    std::vector<int> expired;
+    for (auto& kv : conns) {
+        const Connection& c = *kv.second;
+
+        // Keep-alive đang chờ request kế tiếp -> dùng keepAliveTimeout
+        bool idleKeepAlive = c.requestsServed > 0 && c.inBuf.empty();
+        if (c.lastActive < (idleKeepAlive ? idleDeadline : ioDeadline)) {
+            expired.push_back(kv.first);
+        }
+    }
+    for (int fd : expired) closeConnection(fd);
+}
@@ -1,21 +1,91 @@
 #include "core/Response.hpp"
 
-std::string Response::build() const {
-    std::string res;
+#include <unistd.h>
+
+#include <charconv>
 
-    res += "HTTP/1.1 " + std::to_string(statusCode) + " " + statusText + "\r\n";
+FileBody::~FileBody() {
+    if (fd >= 0) ::close(fd);
+}
+
+std::size_t FileBody::bodyLength() const {
+    if (parts.empty()) return length;
 
-    // Luôn tự set Content-Length
-    res += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    std::size_t total = trailer.size();
+    for (const auto& p : parts) total += p.head.size() + p.length;
+    return total;
+}
+
+std::string_view Response::internedStatusLine(int code) {
+    switch (code) {
+    case 100: return "HTTP/1.1 100 Continue\r\n";
+    case 200: return "HTTP/1.1 200 OK\r\n";
+    case 201: return "HTTP/1.1 201 Created\r\n";
+    case 204: return "HTTP/1.1 204 No Content\r\n";
+    case 206: return "HTTP/1.1 206 Partial Content\r\n";
+    case 304: return "HTTP/1.1 304 Not Modified\r\n";
+    case 400: return "HTTP/1.1 400 Bad Request\r\n";
+    case 403: return "HTTP/1.1 403 Forbidden\r\n";
+    case 404: return "HTTP/1.1 404 Not Found\r\n";
+    case 405: return "HTTP/1.1 405 Method Not Allowed\r\n";
+    case 413: return "HTTP/1.1 413 Content Too Large\r\n";
+    case 416: return "HTTP/1.1 416 Range Not Satisfiable\r\n";
+    case 500: return "HTTP/1.1 500 Internal Server Error\r\n";
+    case 503: return "HTTP/1.1 503 Service Unavailable\r\n";
+    default:  return {};
+    }
+}
+
+int Response::toIovecs(iovec* iov, std::string& scratch) const {
+    scratch.clear();
+
+    // Status line: dùng bản dựng sẵn nếu statusText đúng như bảng ("HTTP/1.1 NNN " = 13 byte)
+    std::string_view status = internedStatusLine(statusCode);
+    std::size_t statusLen = 0;
+    if (status.empty() || status.substr(13, status.size() - 15) != statusText) {
+        char code[8];
+        auto r = std::to_chars(code, code + sizeof(code), statusCode);
+        scratch.append("HTTP/1.1 ").append(code, r.ptr).append(" ").append(statusText).append("\r\n");
+        statusLen = scratch.size();
+    }
+
+    // Luôn tự set Content-Length (trừ khi body được stream theo chunk / tới lúc đóng connection)
+    if (chunked) {
+        scratch.append("Transfer-Encoding: chunked\r\n");
+    } else if (!closeDelimited) {
+        char len[24];
+        auto r = std::to_chars(len, len + sizeof(len), contentLength());
+        scratch.append("Content-Length: ").append(len, r.ptr).append("\r\n");
+    }
 
-    // Thêm tất cả header
     for (const auto& h : headers) {
-        res += h.first + ": " + h.second + "\r\n";
+        scratch.append(h.first).append(": ").append(h.second).append("\r\n");
     }
+    scratch.append(connectionHeaders).append("\r\n");
 
-    res += "\r\n";
-    res += body;
+    // Con trỏ vào scratch lấy sau cùng (append có thể cấp phát lại)
+    if (statusLen > 0) {
+        iov[0] = {scratch.data(), statusLen};
+    } else {
+        iov[0] = {const_cast<char*>(status.data()), status.size()};
+    }
+    iov[1] = {scratch.data() + statusLen, scratch.size() - statusLen};
 
-    return res;
+    // Body dạng file được gửi riêng (SslIO::sendFile), body chunked do ChunkedWriter gửi
+    if (file || chunked || closeDelimited || body.empty()) return 2;
+    iov[2] = {const_cast<char*>(body.data()), body.size()};
+    return 3;
 }
 
+std::string Response::build() const {
+    iovec iov[MAX_IOV];
+    std::string scratch;
+    int n = toIovecs(iov, scratch);
+
+    std::string res;
+    std::size_t total = 0;
+    for (int i = 0; i < n; ++i) total += iov[i].iov_len;
+    res.reserve(total);
+    for (int i = 0; i < n; ++i) res.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+    return res;
+}
@@ -2,6 +2,7 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <iostream>
 #include <netinet/tcp.h>   // TCP_NODELAY
 
@@ -49,7 +50,14 @@ bool Socket::listen() {
 }
 
 int Socket::acceptClient() {
-    return ::accept(serverFd, nullptr, nullptr);
+    // client fd luôn non-blocking, do Reactor điều khiển qua epoll
+    return ::accept4(serverFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+}
+
+bool Socket::setNonBlocking() {
+    int flags = fcntl(serverFd, F_GETFL, 0);
+    if (flags < 0) return false;
+    return fcntl(serverFd, F_SETFL, flags | O_NONBLOCK) >= 0;
 }
 
 void Socket::closeSocket() {
@@ -0,0 +1,326 @@
+#include "core/SslIO.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/Connection.hpp"
+
+// OpenSSL
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+namespace SslIO {
+
+// mmap fallback: map từng cửa sổ để không giữ cả file multi-MB trong address space
+static constexpr std::size_t MMAP_WINDOW = 4 * 1024 * 1024;
+
+bool waitFd(int fd, short events, int timeoutMs) {
+    pollfd pfd{};
+    pfd.fd = fd;
+    pfd.events = events;
+    int r;
+    do {
+        r = poll(&pfd, 1, timeoutMs);
+    } while (r < 0 && errno == EINTR);
+    return r > 0;
+}
+
+bool sendAll(SSL* ssl, const char* data, std::size_t len) {
+    if (!ssl) return false;
+    std::size_t total = 0;
+
+    while (total < len) {
+        std::size_t remain = len - total;
+        int sent = SSL_write(ssl, data + total, static_cast<int>(std::min<std::size_t>(remain, INT32_MAX)));
+        if (sent <= 0) {
+            int err = SSL_get_error(ssl, sent);
+
+            if (err == SSL_ERROR_WANT_WRITE || err == SSL_ERROR_WANT_READ) {
+                // socket non-blocking: chờ tới khi ghi/đọc được
+                short ev = (err == SSL_ERROR_WANT_WRITE) ? POLLOUT : POLLIN;
+                if (!waitFd(SSL_get_fd(ssl), ev, SEND_TIMEOUT_MS)) return false;
+                continue;
+            }
+            ERR_print_errors_fp(stderr);
+            return false;
+        }
+
+        total += static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool ktlsSendActive(SSL* ssl) {
+    if (!ssl) return false;
+    return BIO_get_ktls_send(SSL_get_wbio(ssl)) != 0;
+}
+
+// kTLS: kernel đọc page cache + mã hóa, không có copy nào ở user-space
+static bool sendRangeKtls(SSL* ssl, int fd, off_t offset, std::size_t length) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+    off_t off = offset;
+    std::size_t remain = length;
+
+    while (remain > 0) {
+        ossl_ssize_t n = SSL_sendfile(ssl, fd, off, remain, 0);
+        if (n <= 0) {
+            int err = SSL_get_error(ssl, (int)n);
+            if (err == SSL_ERROR_WANT_WRITE || err == SSL_ERROR_WANT_READ) {
+                short ev = (err == SSL_ERROR_WANT_WRITE) ? POLLOUT : POLLIN;
+                if (!waitFd(SSL_get_fd(ssl), ev, SEND_TIMEOUT_MS)) return false;
+                continue;
+            }
+            ERR_print_errors_fp(stderr);
+            return false;
+        }
+        off += n;
+        remain -= static_cast<std::size_t>(n);
+    }
+    return true;
+#else
+    (void)ssl;
+    (void)fd;
+    (void)offset;
+    (void)length;
+    return false;
+#endif
+}
+
+// Fallback: SSL_write thẳng từ vùng mmap (bỏ qua ifstream/ostringstream/body copy).
+// Chỉ map phần [offset, offset + length) nên range nhỏ chỉ chạm đúng các page cần
+static bool sendRangeMmap(SSL* ssl, int fd, off_t offset, std::size_t length) {
+    static const long page = sysconf(_SC_PAGESIZE);
+
+    off_t pos = offset;
+    std::size_t remain = length;
+
+    while (remain > 0) {
+        off_t aligned = pos - pos % page;
+        std::size_t delta = static_cast<std::size_t>(pos - aligned);
+        std::size_t span = std::min(remain, MMAP_WINDOW);
+
+        void* map = mmap(nullptr, span + delta, PROT_READ, MAP_PRIVATE, fd, aligned);
+        if (map == MAP_FAILED) return false;
+        madvise(map, span + delta, MADV_SEQUENTIAL);
+
+        bool ok = sendAll(ssl, static_cast<const char*>(map) + delta, span);
+        munmap(map, span + delta);
+        if (!ok) return false;
+
+        pos += static_cast<off_t>(span);
+        remain -= span;
+    }
+    return true;
+}
+
+static bool sendRange(SSL* ssl, bool ktls, int fd, off_t offset, std::size_t length) {
+    if (length == 0) return true;
+    return ktls ? sendRangeKtls(ssl, fd, offset, length) : sendRangeMmap(ssl, fd, offset, length);
+}
+
+bool sendFile(SSL* ssl, const FileBody& f) {
+    if (!ssl || f.fd < 0) return false;
+
+    bool ktls = ktlsSendActive(ssl);
+    if (f.parts.empty()) return sendRange(ssl, ktls, f.fd, f.offset, f.length);
+
+    // multipart/byteranges: header từng part + đoạn file tương ứng
+    for (const auto& p : f.parts) {
+        if (!sendAll(ssl, p.head.data(), p.head.size())) return false;
+        if (!sendRange(ssl, ktls, f.fd, p.offset, p.length)) return false;
+    }
+    return sendAll(ssl, f.trailer.data(), f.trailer.size());
+}
+
+// =======================
+//  Theo Connection (TLS hoặc plaintext)
+// =======================
+static bool writevAll(int fd, const iovec* iov, int count) {
+    iovec local[Response::MAX_IOV + 1];
+    constexpr int BATCH = (int)(sizeof(local) / sizeof(local[0]));
+
+    while (count > 0) {
+        int left = std::min(count, BATCH);
+        std::copy(iov, iov + left, local);
+        iov += left;
+        count -= left;
+
+        iovec* cur = local;
+        while (left > 0) {
+            ssize_t w = ::writev(fd, cur, left);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    if (!waitFd(fd, POLLOUT, SEND_TIMEOUT_MS)) return false;
+                    continue;
+                }
+                return false;
+            }
+
+            // Ghi thiếu: bỏ các iovec đã xong, dịch đầu iovec đang dở
+            std::size_t done = static_cast<std::size_t>(w);
+            while (left > 0 && done >= cur->iov_len) {
+                done -= cur->iov_len;
+                ++cur;
+                --left;
+            }
+            if (left > 0) {
+                cur->iov_base = static_cast<char*>(cur->iov_base) + done;
+                cur->iov_len -= done;
+            }
+        }
+    }
+    return true;
+}
+
+// Gom các đoạn vào 1 record rồi SSL_write: header + đầu body đi chung 1 record
+// thay vì mỗi đoạn 1 record riêng
+static bool sendvTls(SSL* ssl, const iovec* iov, int count) {
+    thread_local char record[TLS_RECORD_BYTES];
+    std::size_t used = 0;
+
+    for (int i = 0; i < count; ++i) {
+        const char* p = static_cast<const char*>(iov[i].iov_base);
+        std::size_t n = iov[i].iov_len;
+
+        while (n > 0) {
+            // Buffer trống và đoạn còn lại >= 1 record: gửi thẳng, khỏi copy
+            if (used == 0 && n >= TLS_RECORD_BYTES) {
+                if (!sendAll(ssl, p, n)) return false;
+                break;
+            }
+            std::size_t k = std::min(n, TLS_RECORD_BYTES - used);
+            std::memcpy(record + used, p, k);
+            used += k;
+            p += k;
+            n -= k;
+
+            if (used == TLS_RECORD_BYTES) {
+                if (!sendAll(ssl, record, used)) return false;
+                used = 0;
+            }
+        }
+    }
+    return used == 0 || sendAll(ssl, record, used);
+}
+
+bool send(Connection& conn, const char* data, std::size_t len) {
+    bool ok;
+    if (conn.ssl) {
+        ok = sendAll(conn.ssl, data, len);
+    } else {
+        iovec iov{const_cast<char*>(data), len};
+        ok = writevAll(conn.fd, &iov, 1);
+    }
+    if (ok) conn.bytesSent += len;
+    return ok;
+}
+
+bool sendv(Connection& conn, const iovec* iov, int count) {
+    bool ok = conn.ssl ? sendvTls(conn.ssl, iov, count) : writevAll(conn.fd, iov, count);
+    if (ok) {
+        for (int i = 0; i < count; ++i) conn.bytesSent += iov[i].iov_len;
+    }
+    return ok;
+}
+
+TrySend trySend(Connection& conn, const char* data, std::size_t len, std::size_t& sent) {
+    sent = 0;
+    TrySend st = TrySend::Done;
+    while (sent < len) {
+        if (conn.ssl) {
+            int n = SSL_write(conn.ssl, data + sent, static_cast<int>(std::min<std::size_t>(len - sent, INT32_MAX)));
+            if (n <= 0) {
+                int err = SSL_get_error(conn.ssl, n);
+                st = err == SSL_ERROR_WANT_WRITE ? TrySend::WantWrite
+                   : err == SSL_ERROR_WANT_READ  ? TrySend::WantRead
+                                                 : TrySend::Error;
+                break;
+            }
+            sent += static_cast<std::size_t>(n);
+        } else {
+            ssize_t n = ::write(conn.fd, data + sent, len - sent);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                st = (errno == EAGAIN || errno == EWOULDBLOCK) ? TrySend::WantWrite : TrySend::Error;
+                break;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+    }
+    conn.bytesSent += sent;
+    return st;
+}
+
+static bool sendRangePlain(int sock, int fd, off_t offset, std::size_t length) {
+    off_t off = offset;
+    std::size_t remain = length;
+
+    while (remain > 0) {
+        ssize_t n = ::sendfile(sock, fd, &off, remain);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (!waitFd(sock, POLLOUT, SEND_TIMEOUT_MS)) return false;
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) return false;  // file bị cắt ngắn giữa chừng
+        remain -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// Tổng byte FileBody đưa ra socket (các phần multipart gồm cả head + trailer)
+static std::uint64_t fileBodyBytes(const FileBody& f) {
+    if (f.parts.empty()) return f.length;
+    std::uint64_t n = f.trailer.size();
+    for (const auto& p : f.parts) n += p.head.size() + p.length;
+    return n;
+}
+
+bool sendFile(Connection& conn, const FileBody& f) {
+    if (conn.ssl) {
+        if (!sendFile(conn.ssl, f)) return false;
+        conn.bytesSent += fileBodyBytes(f);
+        return true;
+    }
+    if (f.fd < 0) return false;
+
+    if (f.parts.empty()) {
+        if (!sendRangePlain(conn.fd, f.fd, f.offset, f.length)) return false;
+        conn.bytesSent += f.length;
+        return true;
+    }
+
+    // head / trailer đi qua send(conn) nên đã được đếm
+    for (const auto& p : f.parts) {
+        if (!send(conn, p.head.data(), p.head.size())) return false;
+        if (!sendRangePlain(conn.fd, f.fd, p.offset, p.length)) return false;
+        conn.bytesSent += p.length;
+    }
+    return send(conn, f.trailer.data(), f.trailer.size());
+}
+
+bool sendResponse(Connection& conn, const Response& res) {
+    // scratch dùng lại giữa các response của cùng thread, không cấp phát lại mỗi lần
+    thread_local std::string scratch;
+    iovec iov[Response::MAX_IOV];
+
+    int n = res.toIovecs(iov, scratch);
+    if (!sendv(conn, iov, n)) return false;
+
+    // File lớn: kTLS + SSL_sendfile, mmap hoặc sendfile thường, không qua res.body
+    return !res.file || sendFile(conn, *res.file);
+}
+
+}  // namespace SslIO
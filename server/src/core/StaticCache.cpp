@@ -0,0 +1,268 @@
+#include "core/StaticCache.hpp"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+static constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_DELETE |
+                                       IN_MOVED_FROM | IN_MOVED_TO | IN_CREATE |
+                                       IN_DELETE_SELF | IN_MOVE_SELF;
+
+StaticCache::StaticCache(const std::string& root, std::size_t maxBytes, std::size_t maxEntryBytes)
+    : root(root), maxBytes(maxBytes), maxEntryBytes(std::min(maxEntryBytes, maxBytes)) {
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (inotifyFd < 0 || stopFd < 0) {
+        // Không có inotify thì không thể biết file đổi -> không cache
+        std::cerr << "[CACHE] inotify unavailable, static cache disabled\n";
+        this->maxBytes = 0;
+        return;
+    }
+
+    addWatchRecursive(root);
+    watcher = std::thread([this]() { watchLoop(); });
+
+    std::cout << "[CACHE] Static cache: root=" << root << " cap=" << maxBytes
+              << " max_entry=" << this->maxEntryBytes << "\n";
+}
+
+StaticCache::~StaticCache() {
+    if (stopFd >= 0) {
+        uint64_t one = 1;
+        ssize_t n = ::write(stopFd, &one, sizeof(one));
+        (void)n;
+    }
+    if (watcher.joinable()) watcher.join();
+    if (inotifyFd >= 0) ::close(inotifyFd);
+    if (stopFd >= 0) ::close(stopFd);
+}
+
+const char* StaticCache::mimeType(const std::string& path) {
+    static const std::unordered_map<std::string, const char*> types = {
+        {"html", "text/html"},
+        {"css", "text/css"},
+        {"js", "application/javascript"},
+        {"png", "image/png"},
+        {"jpg", "image/jpeg"},
+        {"jpeg", "image/jpeg"},
+    };
+
+    auto dot = path.rfind('.');
+    if (dot != std::string::npos && path.find('/', dot) == std::string::npos) {
+        auto it = types.find(path.substr(dot + 1));
+        if (it != types.end()) return it->second;
+    }
+    return "application/octet-stream";
+}
+
+// =======================
+//  Lookup / load
+// =======================
+std::shared_ptr<const StaticCache::Asset> StaticCache::get(const std::string& fullPath) {
+    if (maxBytes == 0) return nullptr;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = map.find(fullPath);
+        if (it != map.end()) {
+            it->second->lastUsed.store(tick.fetch_add(1, std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second->asset;
+        }
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return load(fullPath);
+}
+
+std::shared_ptr<const StaticCache::Asset> StaticCache::load(const std::string& fullPath) {
+    std::uint64_t gen = generation.load(std::memory_order_acquire);
+
+    int fd = ::open(fullPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+        static_cast<std::size_t>(st.st_size) > maxEntryBytes) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    auto asset = std::make_shared<Asset>();
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    asset->body.resize(size);
+
+    std::size_t got = 0;
+    while (got < size) {
+        ssize_t n = pread(fd, &asset->body[got], size - got, static_cast<off_t>(got));
+        if (n <= 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    ::close(fd);
+    asset->body.resize(got);
+
+    asset->head = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(got) +
+                  "\r\nContent-Type: " + mimeType(fullPath) + "\r\n";
+
+    std::unique_lock<std::shared_mutex> lock(mtx);
+
+    // File đổi trong lúc đang đọc -> trả bản vừa đọc nhưng không cache
+    if (generation.load(std::memory_order_acquire) != gen) return asset;
+
+    auto it = map.find(fullPath);
+    if (it != map.end()) return it->second->asset;  // thread khác nạp trước
+
+    evictLocked(asset->bytes());
+
+    auto slot = std::make_unique<Slot>();
+    slot->asset = asset;
+    slot->lastUsed.store(tick.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    usedBytes += asset->bytes();
+    map.emplace(fullPath, std::move(slot));
+
+    return asset;
+}
+
+void StaticCache::evictLocked(std::size_t incoming) {
+    // LRU xấp xỉ: bỏ entry có lastUsed nhỏ nhất (số asset ít, quét tuyến tính là đủ)
+    while (!map.empty() && usedBytes + incoming > maxBytes) {
+        auto victim = map.begin();
+        std::uint64_t oldest = victim->second->lastUsed.load(std::memory_order_relaxed);
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            std::uint64_t t = it->second->lastUsed.load(std::memory_order_relaxed);
+            if (t < oldest) {
+                oldest = t;
+                victim = it;
+            }
+        }
+        usedBytes -= victim->second->asset->bytes();
+        map.erase(victim);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void StaticCache::invalidate(const std::string& fullPath) {
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    generation.fetch_add(1, std::memory_order_release);
+
+    auto it = map.find(fullPath);
+    if (it == map.end()) return;
+
+    usedBytes -= it->second->asset->bytes();
+    map.erase(it);
+    invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StaticCache::invalidatePrefix(const std::string& dirPath) {
+    std::string prefix = dirPath + "/";
+
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    generation.fetch_add(1, std::memory_order_release);
+
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) == 0) {
+            usedBytes -= it->second->asset->bytes();
+            it = map.erase(it);
+            invalidations.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++it;
+        }
+    }
+}
+
+StaticCache::Stats StaticCache::stats() const {
+    Stats s{};
+    s.hits = hits.load(std::memory_order_relaxed);
+    s.misses = misses.load(std::memory_order_relaxed);
+    s.evictions = evictions.load(std::memory_order_relaxed);
+    s.invalidations = invalidations.load(std::memory_order_relaxed);
+    s.capacity = maxBytes;
+
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    s.entries = map.size();
+    s.bytes = usedBytes;
+    return s;
+}
+
+// =======================
+//  inotify
+// =======================
+void StaticCache::addWatchRecursive(const std::string& dir) {
+    int wd = inotify_add_watch(inotifyFd, dir.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        std::cerr << "[CACHE] inotify_add_watch failed: " << dir << "\n";
+        return;
+    }
+    watchDirs[wd] = dir;
+
+    DIR* d = opendir(dir.c_str());
+    if (!d) return;
+    while (dirent* e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name == "." || name == "..") continue;
+
+        std::string child = dir + "/" + name;
+        struct stat st {};
+        if (stat(child.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) addWatchRecursive(child);
+    }
+    closedir(d);
+}
+
+void StaticCache::watchLoop() {
+    alignas(inotify_event) char buf[16384];
+
+    while (true) {
+        pollfd pfds[2] = {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+        int r = poll(pfds, 2, -1);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (pfds[1].revents) return;
+
+        ssize_t len;
+        while ((len = ::read(inotifyFd, buf, sizeof(buf))) > 0) {
+            for (char* p = buf; p < buf + len;) {
+                auto* ev = reinterpret_cast<inotify_event*>(p);
+                p += sizeof(inotify_event) + ev->len;
+
+                if (ev->mask & IN_Q_OVERFLOW) {
+                    // Mất event -> không tin được cache nữa
+                    invalidatePrefix(root);
+                    continue;
+                }
+
+                auto it = watchDirs.find(ev->wd);
+                if (it == watchDirs.end()) continue;
+                std::string dir = it->second;
+
+                if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    invalidatePrefix(dir);
+                    if (ev->mask & IN_IGNORED) watchDirs.erase(it);
+                    continue;
+                }
+                if (ev->len == 0) continue;
+
+                std::string path = dir + "/" + ev->name;
+                if (ev->mask & IN_ISDIR) {
+                    invalidatePrefix(path);
+                    if (ev->mask & (IN_CREATE | IN_MOVED_TO)) addWatchRecursive(path);
+                } else {
+                    invalidate(path);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#include "core/UploadFile.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "monitor/Tracer.hpp"
+
+// =======================
+//  IO thread ghi mọi upload (reactor không bao giờ gọi write(2) xuống đĩa)
+// =======================
+struct UploadIO {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::shared_ptr<UploadFile>> queue;  // file còn backlog, round-robin
+    bool stopping = false;
+    std::thread thread;
+
+    UploadIO() : thread([this] { run(); }) {}
+
+    // Hết process: ghi nốt backlog còn lại rồi mới join
+    ~UploadIO() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    void post(std::shared_ptr<UploadFile> f) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            queue.push_back(std::move(f));
+        }
+        cv.notify_one();
+    }
+
+    void run();
+};
+
+static UploadIO& uploadIO() {
+    static UploadIO io;
+    return io;
+}
+
+static bool writeAll(int fd, const char* data, std::size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+void UploadIO::run() {
+    Tracer::setThreadName("upload-io");
+    std::string buf;
+
+    while (true) {
+        std::shared_ptr<UploadFile> f;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            f = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        // Lấy cả backlog đi ghi (buf rỗng đổi chỗ -> backlog giữ lại capacity cũ),
+        // reactor đang chờ thì cho đọc tiếp song song với lúc ghi
+        std::function<void()> wake;
+        buf.clear();
+        {
+            std::lock_guard<std::mutex> lock(f->mtx);
+            buf.swap(f->backlog);
+            wake = std::move(f->onDrained);
+            f->onDrained = nullptr;
+        }
+        if (wake) wake();
+
+        bool ok = writeAll(f->fd, buf.data(), buf.size());
+        int err = ok ? 0 : errno;
+
+        bool more;
+        {
+            std::lock_guard<std::mutex> lock(f->mtx);
+            if (!ok) {
+                std::cerr << "[UPLOAD] write failed for " << f->targetPath << ", errno=" << err << "\n";
+                f->failed = true;
+                f->backlog.clear();
+                wake = std::move(f->onDrained);
+                f->onDrained = nullptr;
+            }
+            more = !f->backlog.empty();
+            if (!more) {
+                f->queued = false;
+                f->idleCv.notify_all();
+            }
+        }
+        if (wake) wake();
+        if (more) post(std::move(f));
+    }
+}
+
+UploadFile::UploadFile(int fd, std::string tempPath, std::string targetPath)
+    : fd(fd), tempPath(std::move(tempPath)), targetPath(std::move(targetPath)) {}
+
+UploadFile::~UploadFile() {
+    if (fd >= 0) ::close(fd);
+    if (!committed) ::unlink(tempPath.c_str());
+}
+
+std::shared_ptr<UploadFile> UploadFile::create(const std::string& target) {
+    std::filesystem::path dir = std::filesystem::path(target).parent_path();
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) {
+        std::cerr << "[UPLOAD] Cannot create directory " << dir << ": " << ec.message() << "\n";
+        return nullptr;
+    }
+
+    std::string tmpl = (dir / ".upload-XXXXXX").string();
+    std::vector<char> buf(tmpl.begin(), tmpl.end());
+    buf.push_back('\0');
+
+    int fd = mkostemp(buf.data(), O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "[UPLOAD] mkostemp failed in " << dir << ", errno=" << errno << "\n";
+        return nullptr;
+    }
+    // mkstemp tạo với quyền 0600, file upload cần đọc được như file thường
+    fchmod(fd, 0644);
+
+    return std::shared_ptr<UploadFile>(new UploadFile(fd, buf.data(), target));
+}
+
+bool UploadFile::append(const char* data, std::size_t len) {
+    bool post = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (failed) return false;
+        backlog.append(data, len);
+        if (!queued) {
+            queued = true;
+            post = true;
+        }
+    }
+    if (post) uploadIO().post(shared_from_this());
+    return true;
+}
+
+bool UploadFile::pauseUntilDrained(std::function<void()> fn) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (failed || backlog.size() <= MAX_BACKLOG) return false;
+    onDrained = std::move(fn);
+    return true;
+}
+
+bool UploadFile::commit() {
+    if (committed) return true;
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        idleCv.wait(lock, [this] { return !queued; });
+        if (failed) return false;
+    }
+
+    if (fd >= 0) {
+        int rc = ::close(fd);
+        fd = -1;
+        if (rc != 0) return false;
+    }
+
+    if (::rename(tempPath.c_str(), targetPath.c_str()) != 0) {
+        std::cerr << "[UPLOAD] rename to " << targetPath << " failed, errno=" << errno << "\n";
+        return false;
+    }
+    committed = true;
+    return true;
+}
@@ -6,7 +6,6 @@
 
 int main(int argc, char* argv[]) {
     signal(SIGPIPE, SIG_IGN);
-    SystemMetrics::init();
 
     // Default algorithm = ADAPTIVE
     std::string algo = "ADAPTIVE";
@@ -22,10 +21,36 @@ int main(int argc, char* argv[]) {
     std::cout << "[MAIN] Scheduling algorithm = " << algo << "\n";
 
     Config cfg("config/server.json");
-
-    HttpServer server(cfg.port, cfg.threads, algo);
+    SystemMetrics::init(std::chrono::milliseconds(cfg.cpu_sample_ms));
+
+    ServerOptions opts;
+    opts.acceptors      = cfg.acceptors;
+    opts.pinAcceptors   = cfg.pin_acceptors;
+    opts.shardScheduler = cfg.shard_scheduler;
+    opts.workStealing   = cfg.work_stealing;
+    opts.keepAliveTimeoutSec = cfg.keepalive_timeout;
+    opts.maxRequestsPerConn  = cfg.keepalive_max_requests;
+    opts.tlsSessionCacheSize  = cfg.tls_session_cache_size;
+    opts.tlsSessionTimeoutSec = cfg.tls_session_timeout;
+    opts.tlsTicketRotateSec   = cfg.tls_ticket_rotate;
+    opts.handshakeThreads     = cfg.handshake_threads;
+    opts.tls                  = cfg.tls;
+    opts.ktls                 = cfg.ktls;
+    opts.zeroCopyMinBytes     = cfg.zero_copy_min_bytes;
+    opts.staticCacheBytes     = cfg.static_cache_bytes;
+    opts.staticCacheMaxEntry  = cfg.static_cache_max_entry;
+    opts.maxBodyBytes         = cfg.max_body_bytes;
+    opts.maxUploadBytes       = cfg.max_upload_bytes;
+    opts.logFlushMs           = cfg.log_flush_ms;
+    opts.logBinary            = cfg.log_format == "binary";
+    opts.logSegmentBytes      = cfg.log_segment_bytes;
+    opts.traceEnabled         = cfg.trace_enabled;
+    opts.traceBufferEvents    = cfg.trace_buffer_events;
+
+    HttpServer server(cfg.port, cfg.threads, algo, opts);
     server.start();
 
+    SystemMetrics::stop();
     return 0;
 }
 
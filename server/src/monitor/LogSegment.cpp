@@ -0,0 +1,260 @@
+#include "monitor/LogSegment.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+
+namespace LogSegment {
+
+const char* const CSV_HEADER =
+    "timestamp,"
+    "cpu,"
+    "queue_len,"
+    "request_method,"
+    "request_path_length,"
+    "estimated_workload,"
+    "algo_at_enqueue,"
+    "algo_at_run,"
+    "req_size,"
+    "response_ms,"
+    "latency_avg,"
+    "queue_ms,"
+    "service_ms,"
+    "write_ms,"
+    "handshake_ms,"
+    "read_ms\n";
+
+// Tên dài đúng NAME_LEN (vd. ADAPTIVE) thì không có '\0'
+static void putName(char (&dst)[NAME_LEN], const char* name) {
+    std::memcpy(dst, name, std::min(std::strlen(name), NAME_LEN));
+}
+
+static constexpr HttpMethod METHODS[] = {HttpMethod::GET,    HttpMethod::POST, HttpMethod::PUT,
+                                         HttpMethod::DELETE, HttpMethod::HEAD, HttpMethod::OTHER};
+static constexpr SchedAlgo ALGOS[] = {SchedAlgo::FIFO, SchedAlgo::SJF, SchedAlgo::RR,
+                                      SchedAlgo::WFQ, SchedAlgo::ADAPTIVE};
+
+Header makeHeader() {
+    Header h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.recordSize = sizeof(Record);
+    // Mã = giá trị enum -> đặt tên đúng vị trí
+    for (HttpMethod m : METHODS) {
+        putName(h.methods[(int)m], httpMethodName(m));
+        h.methodCount = std::max<std::uint8_t>(h.methodCount, (std::uint8_t)((int)m + 1));
+    }
+    for (SchedAlgo a : ALGOS) {
+        putName(h.algos[(int)a], schedAlgoName(a));
+        h.algoCount = std::max<std::uint8_t>(h.algoCount, (std::uint8_t)((int)a + 1));
+    }
+    return h;
+}
+
+Record toRecord(const LogEntry& e) {
+    Record r{};
+    r.timestampNs = e.timestamp_ns;
+    r.cpu = (float)e.cpu;
+    r.queueLen = (std::uint32_t)std::min<std::uint64_t>(e.queue_len, UINT32_MAX);
+    r.pathLength = e.request_path_length;
+    r.estimatedWorkload = e.estimated_workload;
+    r.reqSize = (std::uint32_t)std::min<std::uint64_t>(e.req_size, UINT32_MAX);
+    r.responseMs = (float)e.response_time_ms;
+    r.latencyAvg = (float)e.prev_latency_avg;
+    r.queueMs = (float)e.queue_ms;
+    r.serviceMs = (float)e.service_ms;
+    r.writeMs = (float)e.write_ms;
+    r.handshakeMs = (float)e.handshake_ms;
+    r.readMs = (float)e.read_ms;
+    r.method = (std::uint8_t)e.request_method;
+    r.algoEnqueue = (std::uint8_t)e.algo_at_enqueue;
+    r.algoRun = (std::uint8_t)e.algo_at_run;
+    return r;
+}
+
+std::string segmentPath(const std::string& prefix, std::uint32_t seq) {
+    char num[16];
+    snprintf(num, sizeof(num), ".%06u.bin", seq);
+    return prefix + num;
+}
+
+std::vector<std::string> listSegments(const std::string& prefix) {
+    namespace fs = std::filesystem;
+    fs::path p(prefix);
+    fs::path dir = p.has_parent_path() ? p.parent_path() : fs::path(".");
+    std::string base = p.filename().string() + ".";
+
+    std::vector<std::pair<unsigned long, std::string>> found;
+    std::error_code ec;
+    for (const auto& ent : fs::directory_iterator(dir, ec)) {
+        std::string name = ent.path().filename().string();
+        if (name.size() <= base.size() + 4 || name.compare(0, base.size(), base) != 0) continue;
+        if (name.compare(name.size() - 4, 4, ".bin") != 0) continue;
+
+        std::string digits = name.substr(base.size(), name.size() - base.size() - 4);
+        unsigned long seq = 0;
+        auto res = std::from_chars(digits.data(), digits.data() + digits.size(), seq);
+        if (res.ec != std::errc() || res.ptr != digits.data() + digits.size()) continue;
+        found.emplace_back(seq, ent.path().string());
+    }
+
+    std::sort(found.begin(), found.end());
+    std::vector<std::string> out;
+    out.reserve(found.size());
+    for (auto& f : found) out.push_back(std::move(f.second));
+    return out;
+}
+
+// ---- CSV ----
+
+static void appendNum(std::string& out, std::uint64_t v) {
+    char tmp[24];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    out.append(tmp, res.ptr);
+}
+
+static void appendNum(std::string& out, std::int64_t v) {
+    char tmp[24];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    out.append(tmp, res.ptr);
+}
+
+static void appendNum(std::string& out, double v) {
+    // Giống ostream mặc định (%g, 6 chữ số có nghĩa) như CSV cũ
+    char tmp[32];
+    int n = snprintf(tmp, sizeof(tmp), "%g", v);
+    out.append(tmp, (std::size_t)n);
+}
+
+// Cache theo giây: cùng 1 giây thì không gọi localtime_r lại
+static void appendTimestamp(std::string& out, std::int64_t ns) {
+    static thread_local std::time_t lastSec = -1;
+    static thread_local char lastText[32];
+    static thread_local std::size_t lastLen = 0;
+
+    std::time_t sec = (std::time_t)(ns / 1000000000);
+    if (sec != lastSec) {
+        std::tm tm{};
+        localtime_r(&sec, &tm);
+        lastLen = strftime(lastText, sizeof(lastText), "%Y-%m-%dT%H:%M:%S", &tm);
+        lastSec = sec;
+    }
+    out.append(lastText, lastLen);
+}
+
+void appendCsvRow(std::string& out, std::int64_t timestampNs, double cpu, std::uint64_t queueLen,
+                  const char* method, std::uint64_t pathLength, std::int64_t estimatedWorkload,
+                  const char* algoEnqueue, const char* algoRun, std::uint64_t reqSize,
+                  double responseMs, double latencyAvg, const StageMs& stages) {
+    appendTimestamp(out, timestampNs);
+    out += ',';
+    appendNum(out, cpu);
+    out += ',';
+    appendNum(out, queueLen);
+    out += ',';
+    out += method;
+    out += ',';
+    appendNum(out, pathLength);
+    out += ',';
+    appendNum(out, estimatedWorkload);
+    out += ',';
+    out += algoEnqueue;
+    out += ',';
+    out += algoRun;
+    out += ',';
+    appendNum(out, reqSize);
+    out += ',';
+    appendNum(out, responseMs);
+    out += ',';
+    appendNum(out, latencyAvg);
+    for (double v : {stages.queue, stages.service, stages.write, stages.handshake, stages.read}) {
+        out += ',';
+        appendNum(out, v);
+    }
+    out += '\n';
+}
+
+// ---- Reader ----
+
+Reader::~Reader() { close(); }
+
+void Reader::close() {
+    if (map_) munmap(map_, mapLen_);
+    map_ = nullptr;
+    mapLen_ = 0;
+    records_ = nullptr;
+    count_ = 0;
+}
+
+bool Reader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "[LOG-SEGMENT] cannot open " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(Header)) {
+        std::cerr << "[LOG-SEGMENT] " << path << " too short" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* m = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) {
+        std::cerr << "[LOG-SEGMENT] mmap " << path << " failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    map_ = m;
+    mapLen_ = (std::size_t)st.st_size;
+    madvise(map_, mapLen_, MADV_SEQUENTIAL);
+
+    const Header* h = static_cast<const Header*>(map_);
+    if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->version != VERSION ||
+        h->recordSize != sizeof(Record)) {
+        std::cerr << "[LOG-SEGMENT] " << path << ": bad header (version " << h->version
+                  << ", expected " << VERSION << ")" << std::endl;
+        close();
+        return false;
+    }
+
+    for (std::size_t i = 0; i < DICT_SIZE; ++i) {
+        std::memcpy(methods_[i], h->methods[i], NAME_LEN);
+        std::memcpy(algos_[i], h->algos[i], NAME_LEN);
+    }
+
+    records_ = reinterpret_cast<const Record*>(static_cast<const char*>(map_) + sizeof(Header));
+    count_ = (mapLen_ - sizeof(Header)) / sizeof(Record);
+    return true;
+}
+
+const char* Reader::methodName(std::uint8_t code) const {
+    return code < DICT_SIZE && methods_[code][0] ? methods_[code] : "OTHER";
+}
+
+const char* Reader::algoName(std::uint8_t code) const {
+    return code < DICT_SIZE && algos_[code][0] ? algos_[code] : "UNKNOWN";
+}
+
+void Reader::appendCsv(std::string& out, std::size_t i) const {
+    const Record& r = records_[i];
+    appendCsvRow(out, r.timestampNs, r.cpu, r.queueLen, methodName(r.method), r.pathLength,
+                 r.estimatedWorkload, algoName(r.algoEnqueue), algoName(r.algoRun), r.reqSize,
+                 r.responseMs, r.latencyAvg,
+                 {r.queueMs, r.serviceMs, r.writeMs, r.handshakeMs, r.readMs});
+}
+
+}  // namespace LogSegment
@@ -1,49 +1,267 @@
 #include "monitor/Logger.hpp"
+#include "monitor/LogSegment.hpp"
 
-Logger::Logger(const std::string& filePath) {
-    file.open(filePath, std::ios::out | std::ios::app);
-    if (file.tellp() == 0) {
-        file << "timestamp,"
-        "cpu,"
-        "queue_len,"
-        "request_method,"
-        "request_path_length,"
-        "estimated_workload,"
-        "algo_at_enqueue,"
-        "algo_at_run,"
-        "req_size,"
-        "response_ms,"
-        "latency_avg\n";
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+// Buffer format đạt ngưỡng này thì write() luôn, không đợi gom hết
+static constexpr std::size_t WRITE_CHUNK = 256 * 1024;
+
+static std::atomic<std::uint64_t> nextLoggerId{1};
+
+// Ring SPSC: producer = thread ghi log, consumer = người đang giữ drainMtx
+struct Logger::Ring {
+    alignas(64) std::atomic<std::uint64_t> head{0};  // consumer
+    alignas(64) std::atomic<std::uint64_t> tail{0};  // producer
+    std::uint64_t headCache = 0;                     // producer đọc lại head khi tưởng đầy
+    std::atomic<std::uint64_t> dropped{0};
+    LogEntry slots[RING_CAPACITY];
+};
+
+Logger::Logger(const std::string& path, std::chrono::milliseconds flushInterval, Format format,
+               std::size_t segmentBytes)
+    : format(format), path(path),
+      segmentBytes(std::max(segmentBytes, sizeof(LogSegment::Header) + sizeof(LogSegment::Record))),
+      flushInterval(flushInterval), id(nextLoggerId.fetch_add(1)) {
+    if (format == Format::Binary) {
+        // Chạy tiếp sau segment lớn nhất đã có (không append vào segment cũ có thể ghi dở)
+        auto existing = LogSegment::listSegments(path);
+        if (!existing.empty()) {
+            const std::string& last = existing.back();
+            segmentSeq = (std::uint32_t)std::strtoul(last.c_str() + path.size() + 1, nullptr, 10);
+        }
+        if (!openNextSegment()) return;
+    } else {
+        if (!openCsv()) return;
+    }
+
+    buf.reserve(WRITE_CHUNK + 4096);
+    writer = std::thread([this] { run(); });
+}
+
+bool Logger::openNextSegment() {
+    if (fd >= 0) ::close(fd);
+
+    std::string seg = LogSegment::segmentPath(path, ++segmentSeq);
+    fd = ::open(seg.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[LOGGER] cannot create segment " << seg << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    LogSegment::Header h = LogSegment::makeHeader();
+    if (::write(fd, &h, sizeof(h)) != (ssize_t)sizeof(h)) {
+        std::cerr << "[LOGGER] write segment header failed: " << strerror(errno) << std::endl;
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    segmentSize = sizeof(h);
+    return true;
+}
+
+// Dòng đầu của file có đúng CSV_HEADER không (kể cả '\n')
+static bool csvHeaderMatches(int fd) {
+    const char* header = LogSegment::CSV_HEADER;
+    std::size_t len = strlen(header);
+    std::string first(len, '\0');
+    ssize_t n = pread(fd, &first[0], len, 0);
+    return n == (ssize_t)len && first.compare(0, len, header) == 0;
+}
+
+bool Logger::openCsv() {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[LOGGER] cannot open " << path << ": " << strerror(errno) << std::endl;
+        return false;
     }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) st.st_size = 0;
+
+    // Log của bản cũ (ít cột hơn): dòng mới nằm dưới header cũ sẽ làm hỏng pandas / dashboard
+    if (st.st_size > 0 && !csvHeaderMatches(fd)) {
+        char stamp[32];
+        std::time_t now = std::time(nullptr);
+        std::tm tm{};
+        localtime_r(&now, &tm);
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+        std::string rotated = path + "." + stamp;
+
+        ::close(fd);
+        fd = -1;
+        if (::rename(path.c_str(), rotated.c_str()) != 0) {
+            std::cerr << "[LOGGER] " << path << " has an old header and cannot be rotated: "
+                      << strerror(errno) << std::endl;
+            return false;
+        }
+        std::cout << "[LOGGER] " << path << " header changed, old log moved to " << rotated << std::endl;
+
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            std::cerr << "[LOGGER] cannot open " << path << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+        st.st_size = 0;
+    }
+
+    if (st.st_size == 0) {
+        const char* header = LogSegment::CSV_HEADER;
+        if (::write(fd, header, strlen(header)) < 0) {
+            std::cerr << "[LOGGER] write header failed: " << strerror(errno) << std::endl;
+        }
+    }
+    return true;
 }
 
 Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(stopMtx);
+        stop.store(true, std::memory_order_relaxed);
+    }
+    stopCv.notify_all();
+    if (writer.joinable()) writer.join();
+
     flush();
-    file.close();
+    if (fd >= 0) ::close(fd);
+}
+
+Logger::Ring* Logger::ringForThisThread() {
+    // Cache theo id Logger: thread dùng Logger khác (hoặc Logger mới) thì đăng ký ring mới
+    thread_local std::uint64_t cachedId = 0;
+    thread_local Ring* cachedRing = nullptr;
+    if (cachedId == id) return cachedRing;
+
+    auto ring = std::make_unique<Ring>();
+    Ring* r = ring.get();
+    {
+        std::lock_guard<std::mutex> lock(ringsMtx);
+        rings.push_back(std::move(ring));
+    }
+    cachedId = id;
+    cachedRing = r;
+    return r;
 }
 
 void Logger::log(const LogEntry& e) {
-    std::lock_guard<std::mutex> lock(mtx);
-
-    file << e.timestamp << ","
-     << e.cpu << ","
-     << e.queue_len << ","
-     << e.request_method << ","
-     << e.request_path_length << ","
-     << e.estimated_workload << ","
-     << e.algo_at_enqueue << ","
-     << e.algo_at_run << ","
-     << e.req_size << ","
-     << e.response_time_ms << ","
-     << e.prev_latency_avg << "\n";
-
-    // counter++;
-    // if (counter % 50 == 0)
-    //     file.flush();
-    file.flush();
+    if (!writer.joinable()) return;  // mở file thất bại
+    Ring* r = ringForThisThread();
+
+    std::uint64_t tail = r->tail.load(std::memory_order_relaxed);
+    if (tail - r->headCache >= RING_CAPACITY) {
+        r->headCache = r->head.load(std::memory_order_acquire);
+        if (tail - r->headCache >= RING_CAPACITY) {
+            r->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    r->slots[tail % RING_CAPACITY] = e;
+    r->tail.store(tail + 1, std::memory_order_release);
+}
+
+// ---- format (chỉ thread writer / flush chạy) ----
+
+static void formatCsv(std::string& out, const LogEntry& e) {
+    LogSegment::appendCsvRow(out, e.timestamp_ns, e.cpu, e.queue_len, httpMethodName(e.request_method),
+                             e.request_path_length, e.estimated_workload,
+                             schedAlgoName(e.algo_at_enqueue), schedAlgoName(e.algo_at_run),
+                             e.req_size, e.response_time_ms, e.prev_latency_avg,
+                             {e.queue_ms, e.service_ms, e.write_ms, e.handshake_ms, e.read_ms});
+}
+
+static void writeAll(int fd, std::string& out) {
+    std::size_t off = 0;
+    while (off < out.size()) {
+        ssize_t n = ::write(fd, out.data() + off, out.size() - off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[LOGGER] write failed: " << strerror(errno) << std::endl;
+            break;
+        }
+        off += (std::size_t)n;
+    }
+    out.clear();
+}
+
+void Logger::drainLocked() {
+    if (fd < 0) return;
+    std::vector<Ring*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(ringsMtx);
+        snapshot.reserve(rings.size());
+        for (auto& r : rings) snapshot.push_back(r.get());
+    }
+
+    std::uint64_t count = 0;
+    for (Ring* r : snapshot) {
+        std::uint64_t head = r->head.load(std::memory_order_relaxed);
+        std::uint64_t tail = r->tail.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const LogEntry& e = r->slots[head % RING_CAPACITY];
+            if (format == Format::Csv) {
+                formatCsv(buf, e);
+            } else {
+                // Segment đầy -> ghi phần đang gom rồi sang segment mới
+                if (segmentSize + buf.size() + sizeof(LogSegment::Record) > segmentBytes) {
+                    segmentSize += buf.size();
+                    writeAll(fd, buf);
+                    if (!openNextSegment()) {
+                        buf.clear();
+                        r->head.store(tail, std::memory_order_release);
+                        return;
+                    }
+                }
+                LogSegment::Record rec = LogSegment::toRecord(e);
+                buf.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+            }
+            ++count;
+            if (buf.size() >= WRITE_CHUNK) {
+                r->head.store(head + 1, std::memory_order_release);
+                segmentSize += buf.size();
+                writeAll(fd, buf);
+            }
+        }
+        r->head.store(head, std::memory_order_release);
+    }
+
+    if (!buf.empty()) {
+        segmentSize += buf.size();
+        writeAll(fd, buf);
+    }
+    if (count) written.fetch_add(count, std::memory_order_relaxed);
 }
 
 void Logger::flush() {
-    std::lock_guard<std::mutex> lock(mtx);
-    file.flush();
+    std::lock_guard<std::mutex> lock(drainMtx);
+    drainLocked();
+}
+
+void Logger::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stopMtx);
+            stopCv.wait_for(lock, flushInterval, [this] { return stop.load(std::memory_order_relaxed); });
+        }
+        if (stop.load(std::memory_order_relaxed)) break;
+        flush();
+    }
+}
+
+Logger::Stats Logger::stats() const {
+    Stats s;
+    s.written = written.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(ringsMtx);
+    s.rings = rings.size();
+    for (const auto& r : rings) s.dropped += r->dropped.load(std::memory_order_relaxed);
+    return s;
 }
@@ -0,0 +1,237 @@
+#include "monitor/Metrics.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+static constexpr const char* ROUTE_NAMES[] = {"static", "file_api", "logs", "stats",
+                                              "metrics", "api", "other"};
+static_assert(sizeof(ROUTE_NAMES) / sizeof(ROUTE_NAMES[0]) == Metrics::ROUTES, "route names");
+
+// Biên le xuất ra: 2^k us, k = [MIN_POW, MAX_POW] (16us .. ~34s)
+static constexpr int MIN_POW = 4;
+static constexpr int MAX_POW = 25;
+
+// 1 writer mỗi shard: không cần fetch_add (lock prefix), load + store là đủ
+static inline void bump(std::atomic<std::uint64_t>& c, std::uint64_t v = 1) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+// Không có bộ đếm count riêng: lúc scrape count = tổng các bucket (xem addHist)
+static inline void observe(std::array<std::atomic<std::uint64_t>, LatencyBuckets::COUNT>& buckets,
+                           std::atomic<std::uint64_t>& sum, std::uint64_t us) {
+    bump(buckets[LatencyBuckets::index(us)]);
+    bump(sum, us);
+}
+
+std::uint64_t Metrics::nextId() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+Metrics::Route Metrics::classify(std::string_view method, std::string_view path) {
+    if (path == "/metrics") return Route::Metrics;
+    if (path == "/api/stats") return Route::Stats;
+    if (path == "/api/logs") return Route::Logs;
+    if (path.compare(0, 10, "/api/file/") == 0) return Route::FileApi;
+    if (path.compare(0, 5, "/api/") == 0) return Route::Api;
+    if (method == "GET" || method == "HEAD") return Route::Static;
+    return Route::Other;
+}
+
+const char* Metrics::routeName(Route r) {
+    return ROUTE_NAMES[(std::size_t)r];
+}
+
+Metrics::Shard* Metrics::shardForThisThread() {
+    thread_local std::uint64_t cachedId = 0;
+    thread_local Shard* cachedShard = nullptr;
+    if (cachedId == id) return cachedShard;
+
+    auto shard = std::make_unique<Shard>();
+    Shard* s = shard.get();
+    {
+        std::lock_guard<std::mutex> lock(shardsMtx);
+        shards.push_back(std::move(shard));
+    }
+    cachedId = id;
+    cachedShard = s;
+    return s;
+}
+
+void Metrics::record(const Sample& s) {
+    Shard* sh = shardForThisThread();
+    std::size_t r = (std::size_t)s.route;
+    std::size_t a = (std::size_t)s.algo;
+    if (r >= ROUTES) r = (std::size_t)Route::Other;
+    if (a >= ALGOS) a = 0;
+
+    bump(sh->requests[r][a]);
+    if (s.status > 0 && s.status < MAX_STATUS) bump(sh->status[s.status]);
+    bump(sh->bytesIn, s.bytesIn);
+    bump(sh->bytesOut, s.bytesOut);
+
+    Histogram& qw = sh->queueWait[a];
+    observe(qw.buckets, qw.sumUs, s.queueWaitUs);
+    Histogram& sv = sh->service[r][a];
+    observe(sv.buckets, sv.sumUs, s.serviceUs);
+    Histogram& wr = sh->write[r];
+    observe(wr.buckets, wr.sumUs, s.writeUs);
+    observe(sh->read.buckets, sh->read.sumUs, s.readUs);
+    if (s.firstOnConnection) {
+        observe(sh->handshake.buckets, sh->handshake.sumUs, s.handshakeUs);
+    }
+}
+
+// ---- scrape ----
+
+namespace {
+
+struct HistTotal {
+    std::uint64_t buckets[LatencyBuckets::COUNT] = {};
+    std::uint64_t count = 0;
+    std::uint64_t sumUs = 0;
+};
+
+struct Totals {
+    std::uint64_t requests[Metrics::ROUTES][Metrics::ALGOS] = {};
+    std::uint64_t status[Metrics::MAX_STATUS] = {};
+    std::uint64_t bytesIn = 0;
+    std::uint64_t bytesOut = 0;
+    HistTotal queueWait[Metrics::ALGOS];
+    HistTotal service[Metrics::ROUTES][Metrics::ALGOS];
+    HistTotal write[Metrics::ROUTES];
+    HistTotal read;
+    HistTotal handshake;
+};
+
+void appendf(std::string& out, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+void appendf(std::string& out, const char* fmt, ...) {
+    char tmp[256];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n > 0) out.append(tmp, std::min<std::size_t>((std::size_t)n, sizeof(tmp) - 1));
+}
+
+void renderHistogram(std::string& out, const char* name, const std::string& labels,
+                     const HistTotal& h) {
+    const char* sep = labels.empty() ? "" : ",";
+    std::uint64_t cum = 0;
+    std::size_t b = 0;
+    for (int k = MIN_POW; k <= MAX_POW; ++k) {
+        std::size_t end = LatencyBuckets::firstIndexOfPow2(k);
+        for (; b < end; ++b) cum += h.buckets[b];
+        appendf(out, "%s_bucket{%s%sle=\"%g\"} %llu\n", name, labels.c_str(), sep,
+                (double)(1ull << k) / 1e6, (unsigned long long)cum);
+    }
+    appendf(out, "%s_bucket{%s%sle=\"+Inf\"} %llu\n", name, labels.c_str(), sep,
+            (unsigned long long)h.count);
+    std::string sel = labels.empty() ? std::string() : "{" + labels + "}";
+    appendf(out, "%s_sum%s %.6f\n", name, sel.c_str(), (double)h.sumUs / 1e6);
+    appendf(out, "%s_count%s %llu\n", name, sel.c_str(), (unsigned long long)h.count);
+}
+
+// count = tổng các bucket vừa đọc (không đọc bộ đếm riêng): +Inf và _count luôn
+// >= bucket cuối dù worker đang ghi giữa chừng -> bucket tích luỹ không bao giờ giảm
+void addHist(HistTotal& dst, const std::array<std::atomic<std::uint64_t>, LatencyBuckets::COUNT>& b,
+             const std::atomic<std::uint64_t>& sum) {
+    for (std::size_t i = 0; i < LatencyBuckets::COUNT; ++i) {
+        std::uint64_t v = b[i].load(std::memory_order_relaxed);
+        dst.buckets[i] += v;
+        dst.count += v;
+    }
+    dst.sumUs += sum.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+std::string Metrics::render() const {
+    auto t = std::make_unique<Totals>();
+    {
+        std::lock_guard<std::mutex> lock(shardsMtx);
+        for (const auto& sh : shards) {
+            for (std::size_t r = 0; r < ROUTES; ++r) {
+                for (std::size_t a = 0; a < ALGOS; ++a) {
+                    t->requests[r][a] += sh->requests[r][a].load(std::memory_order_relaxed);
+                    const Histogram& h = sh->service[r][a];
+                    addHist(t->service[r][a], h.buckets, h.sumUs);
+                }
+                addHist(t->write[r], sh->write[r].buckets, sh->write[r].sumUs);
+            }
+            addHist(t->read, sh->read.buckets, sh->read.sumUs);
+            addHist(t->handshake, sh->handshake.buckets, sh->handshake.sumUs);
+            for (int c = 0; c < MAX_STATUS; ++c) t->status[c] += sh->status[c].load(std::memory_order_relaxed);
+            t->bytesIn += sh->bytesIn.load(std::memory_order_relaxed);
+            t->bytesOut += sh->bytesOut.load(std::memory_order_relaxed);
+            for (std::size_t a = 0; a < ALGOS; ++a) {
+                const Histogram& h = sh->queueWait[a];
+                addHist(t->queueWait[a], h.buckets, h.sumUs);
+            }
+        }
+    }
+
+    std::string out;
+    out.reserve(16 * 1024);
+
+    out += "# HELP http_requests_total Requests handled by worker threads.\n"
+           "# TYPE http_requests_total counter\n";
+    for (std::size_t r = 0; r < ROUTES; ++r) {
+        for (std::size_t a = 0; a < ALGOS; ++a) {
+            if (!t->requests[r][a]) continue;
+            appendf(out, "http_requests_total{route=\"%s\",algo=\"%s\"} %llu\n", ROUTE_NAMES[r],
+                    schedAlgoName((SchedAlgo)a), (unsigned long long)t->requests[r][a]);
+        }
+    }
+
+    out += "# HELP http_responses_total Responses by status code.\n"
+           "# TYPE http_responses_total counter\n";
+    for (int c = 0; c < MAX_STATUS; ++c) {
+        if (!t->status[c]) continue;
+        appendf(out, "http_responses_total{code=\"%d\"} %llu\n", c, (unsigned long long)t->status[c]);
+    }
+
+    out += "# HELP http_request_body_bytes_total Request body bytes received.\n"
+           "# TYPE http_request_body_bytes_total counter\n";
+    appendf(out, "http_request_body_bytes_total %llu\n", (unsigned long long)t->bytesIn);
+    out += "# HELP http_response_bytes_total Response bytes written to sockets.\n"
+           "# TYPE http_response_bytes_total counter\n";
+    appendf(out, "http_response_bytes_total %llu\n", (unsigned long long)t->bytesOut);
+
+    out += "# HELP http_queue_wait_seconds Time from enqueue to worker start.\n"
+           "# TYPE http_queue_wait_seconds histogram\n";
+    for (std::size_t a = 0; a < ALGOS; ++a) {
+        if (!t->queueWait[a].count) continue;
+        std::string labels = std::string("algo=\"") + schedAlgoName((SchedAlgo)a) + "\"";
+        renderHistogram(out, "http_queue_wait_seconds", labels, t->queueWait[a]);
+    }
+
+    out += "# HELP http_service_seconds Time from worker start until the response is ready to write.\n"
+           "# TYPE http_service_seconds histogram\n";
+    for (std::size_t r = 0; r < ROUTES; ++r) {
+        for (std::size_t a = 0; a < ALGOS; ++a) {
+            if (!t->service[r][a].count) continue;
+            std::string labels = std::string("route=\"") + ROUTE_NAMES[r] + "\",algo=\"" +
+                                 schedAlgoName((SchedAlgo)a) + "\"";
+            renderHistogram(out, "http_service_seconds", labels, t->service[r][a]);
+        }
+    }
+
+    out += "# HELP http_write_seconds Time spent writing the response to the socket.\n"
+           "# TYPE http_write_seconds histogram\n";
+    for (std::size_t r = 0; r < ROUTES; ++r) {
+        if (!t->write[r].count) continue;
+        renderHistogram(out, "http_write_seconds", std::string("route=\"") + ROUTE_NAMES[r] + "\"",
+                        t->write[r]);
+    }
+
+    out += "# HELP http_read_seconds Time from the first request byte to a fully parsed request.\n"
+           "# TYPE http_read_seconds histogram\n";
+    renderHistogram(out, "http_read_seconds", "", t->read);
+
+    out += "# HELP http_handshake_seconds Time from accept to TLS handshake done (first request per connection).\n"
+           "# TYPE http_handshake_seconds histogram\n";
+    renderHistogram(out, "http_handshake_seconds", "", t->handshake);
+    return out;
+}
@@ -1,82 +1,271 @@
 #include "monitor/SystemMetrics.hpp"
-#include <thread>
+
+#include <sched.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
-#include <chrono>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// ---- busy-time: mỗi thread 1 bộ đếm ns cộng dồn, sampler lấy hiệu giữa 2 lần ----
+
+struct BusySlot {
+    std::atomic<std::uint64_t> ns{0};
+};
+
+std::mutex slotsMtx;
+std::vector<std::unique_ptr<BusySlot>> slots;  // không xoá: thread thoát vẫn giữ tổng của nó
+
+BusySlot* slotForThisThread() {
+    thread_local BusySlot* cached = nullptr;
+    if (cached) return cached;
+
+    auto slot = std::make_unique<BusySlot>();
+    cached = slot.get();
+    std::lock_guard<std::mutex> lock(slotsMtx);
+    slots.push_back(std::move(slot));
+    return cached;
+}
 
-std::atomic<double> SystemMetrics::CPU_CACHE{0.0};
-std::atomic<double> SystemMetrics::BUSY_ACCUM{0.0};
-std::mutex          SystemMetrics::busyMutex;
+std::uint64_t totalBusyNs() {
+    std::uint64_t sum = 0;
+    std::lock_guard<std::mutex> lock(slotsMtx);
+    for (const auto& s : slots) sum += s->ns.load(std::memory_order_relaxed);
+    return sum;
+}
+
+// ---- nguồn CPU của OS ----
+
+// Thư mục cgroup v2 của process ("" nếu không có / đang ở cgroup gốc = cả máy)
+std::string detectCgroupDir() {
+    std::ifstream cg("/proc/self/cgroup");
+    std::string line, path;
+    while (std::getline(cg, line)) {
+        if (line.compare(0, 3, "0::") == 0) path = line.substr(3);
+    }
+    if (path.empty() || path == "/") return "";
+
+    // Điểm mount cgroup2: "... <mount point> ... - cgroup2 ..." trong mountinfo
+    std::ifstream mi("/proc/self/mountinfo");
+    while (std::getline(mi, line)) {
+        auto dash = line.find(" - cgroup2 ");
+        if (dash == std::string::npos) continue;
+        std::istringstream ss(line.substr(0, dash));
+        std::string id, parent, dev, root, mount;
+        ss >> id >> parent >> dev >> root >> mount;
+
+        std::string dir = mount + path;
+        if (std::ifstream(dir + "/cpu.stat").is_open()) return dir;
+    }
+    return "";
+}
+
+bool readCgroupUsageUs(const std::string& dir, std::uint64_t& usageUs) {
+    std::ifstream f(dir + "/cpu.stat");
+    std::string key;
+    std::uint64_t v;
+    while (f >> key >> v) {
+        if (key == "usage_usec") {
+            usageUs = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Số core được dùng: CPU trong affinity, giới hạn thêm bởi quota cpu.max ("max 100000" = không giới hạn)
+double detectCpuLimit(const std::string& cgroupDir) {
+    double cores = (double)std::thread::hardware_concurrency();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) cores = (double)CPU_COUNT(&set);
+
+    if (!cgroupDir.empty()) {
+        std::ifstream f(cgroupDir + "/cpu.max");
+        std::string quota;
+        double period = 0;
+        if (f >> quota >> period && quota != "max" && period > 0) {
+            cores = std::min(cores, std::stod(quota) / period);
+        }
+    }
+    return std::max(cores, 0.01);
+}
 
-// Đọc CPU từ /proc/stat (Linux / WSL)
-static double computeCpu() {
+// Tổng jiffies của dòng "cpu" trong /proc/stat
+bool readProcStat(long& total, long& idle) {
     std::ifstream f("/proc/stat");
-    if (!f.is_open()) return 0.0;
+    if (!f.is_open()) return false;
 
     std::string cpu;
     long u, n, s, i, iw, ir, sf, st;
-    f >> cpu >> u >> n >> s >> i >> iw >> ir >> sf >> st;
+    if (!(f >> cpu >> u >> n >> s >> i >> iw >> ir >> sf >> st)) return false;
 
-    static long prevTotal = 0;
-    static long prevIdle  = 0;
+    idle  = i + iw;
+    total = idle + u + n + s + ir + sf + st;
+    return true;
+}
 
-    long idle    = i + iw;
-    long nonIdle = u + n + s + ir + sf + st;
-    long total   = idle + nonIdle;
+double clampPercent(double v) {
+    return std::clamp(v, 0.0, 100.0);
+}
 
-    long totalDelta = total - prevTotal;
-    long idleDelta  = idle  - prevIdle;
+// ---- thread lấy mẫu ----
 
-    prevTotal = total;
-    prevIdle  = idle;
+struct Sampler {
+    std::mutex ctlMtx;  // init/stop
+    std::thread thread;
 
-    if (totalDelta <= 0) return 0.0;
+    std::mutex stopMtx;
+    std::condition_variable stopCv;
+    bool stopping = false;
 
-    double usage = (double)(totalDelta - idleDelta) / (double)totalDelta * 100.0;
-    if (usage < 0.0)   usage = 0.0;
-    if (usage > 100.0) usage = 100.0;
-    return usage;
-}
+    // Kết quả lần lấy mẫu gần nhất
+    std::atomic<double> combined{0.0};
+    std::atomic<double> osCpu{0.0};
+    std::atomic<double> busyPercent{0.0};
+    std::atomic<double> cpuLimit{0.0};
+    std::atomic<bool> cgroup{false};
+    std::atomic<std::uint64_t> periodMs{0};
 
-void SystemMetrics::init() {
-    // Thread nền: mỗi 200ms đọc CPU OS + snapshot busy-time để tạo CPU tổng hợp
-    std::thread([](){
-        using namespace std::chrono;
-        constexpr double WINDOW_SEC = 0.2;  // 200ms
+    void run(std::chrono::milliseconds period);
 
-        while (true) {
-            double osCpu = computeCpu();
+    // main quên stop(): không để std::thread joinable bị huỷ (terminate)
+    ~Sampler() {
+        if (!thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(stopMtx);
+            stopping = true;
+        }
+        stopCv.notify_all();
+        thread.join();
+    }
+};
 
-            double busySec = 0.0;
-            {
-                std::lock_guard<std::mutex> lock(busyMutex);
-                busySec = BUSY_ACCUM.load();
-                BUSY_ACCUM.store(0.0);
-            }
+Sampler sampler;
 
-            double busyPercent = (busySec / WINDOW_SEC) * 100.0;
-            if (busyPercent < 0.0)   busyPercent = 0.0;
-            if (busyPercent > 100.0) busyPercent = 100.0;
+void Sampler::run(std::chrono::milliseconds period) {
+    std::string cgroupDir = detectCgroupDir();
+    double limit = detectCpuLimit(cgroupDir);
+    cpuLimit.store(limit, std::memory_order_relaxed);
+    cgroup.store(!cgroupDir.empty(), std::memory_order_relaxed);
 
-            // Kết hợp CPU OS và busy-time (50/50)
-            double combined = (osCpu * 0.5) + (busyPercent * 0.5);
-            if (combined < 0.0)   combined = 0.0;
-            if (combined > 100.0) combined = 100.0;
+    std::cout << "[CPU] sampler: period=" << period.count() << "ms cores=" << limit
+              << " source=" << (cgroupDir.empty() ? "/proc/stat" : cgroupDir + "/cpu.stat") << "\n";
 
-            CPU_CACHE.store(combined);
+    // Trạng thái lần trước (chỉ thread này đọc/ghi)
+    auto prevAt = Clock::now();
+    std::uint64_t prevBusy = totalBusyNs();
+    std::uint64_t prevUsageUs = 0;
+    long prevTotal = 0, prevIdle = 0;
+    if (!cgroupDir.empty()) readCgroupUsageUs(cgroupDir, prevUsageUs);
+    else readProcStat(prevTotal, prevIdle);
 
-            std::this_thread::sleep_for(milliseconds(200));
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stopMtx);
+            if (stopCv.wait_for(lock, period, [this] { return stopping; })) break;
         }
-    }).detach();
+
+        auto now = Clock::now();
+        double elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - prevAt).count();
+        prevAt = now;
+        if (elapsedNs <= 0) continue;
+
+        // CPU OS: cgroup = usage của container / (thời gian * số core được cấp)
+        double os = 0.0;
+        if (!cgroupDir.empty()) {
+            std::uint64_t usageUs = prevUsageUs;
+            if (readCgroupUsageUs(cgroupDir, usageUs)) {
+                os = (double)(usageUs - prevUsageUs) * 1000.0 / (elapsedNs * limit) * 100.0;
+                prevUsageUs = usageUs;
+            }
+        } else {
+            long total = 0, idle = 0;
+            if (readProcStat(total, idle)) {
+                long totalDelta = total - prevTotal;
+                long idleDelta  = idle - prevIdle;
+                if (totalDelta > 0) os = (double)(totalDelta - idleDelta) / (double)totalDelta * 100.0;
+                prevTotal = total;
+                prevIdle  = idle;
+            }
+        }
+        os = clampPercent(os);
+
+        // Busy-time worker trên cùng phần CPU được cấp
+        std::uint64_t busy = totalBusyNs();
+        double busyPct = clampPercent((double)(busy - prevBusy) / (elapsedNs * limit) * 100.0);
+        prevBusy = busy;
+
+        osCpu.store(os, std::memory_order_relaxed);
+        busyPercent.store(busyPct, std::memory_order_relaxed);
+
+        // Kết hợp CPU OS và busy-time (50/50)
+        combined.store(clampPercent(os * 0.5 + busyPct * 0.5), std::memory_order_relaxed);
+    }
+}
+
+}  // namespace
+
+void SystemMetrics::init(std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(sampler.ctlMtx);
+    if (sampler.thread.joinable()) return;
+
+    if (period < std::chrono::milliseconds(10)) period = std::chrono::milliseconds(10);
+    sampler.periodMs.store((std::uint64_t)period.count(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> stopLock(sampler.stopMtx);
+        sampler.stopping = false;
+    }
+    sampler.thread = std::thread([period] { sampler.run(period); });
 }
 
-void SystemMetrics::addBusy(double seconds) {
-    if (seconds <= 0.0) return;
-    std::lock_guard<std::mutex> lock(busyMutex);
-    double cur = BUSY_ACCUM.load();
-    BUSY_ACCUM.store(cur + seconds);
+void SystemMetrics::stop() {
+    std::lock_guard<std::mutex> lock(sampler.ctlMtx);
+    if (!sampler.thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> stopLock(sampler.stopMtx);
+        sampler.stopping = true;
+    }
+    sampler.stopCv.notify_all();
+    sampler.thread.join();
 }
 
 double SystemMetrics::getCpuUsage() {
-    return CPU_CACHE.load();
+    return sampler.combined.load(std::memory_order_relaxed);
+}
+
+std::uint64_t SystemMetrics::threadCpuNs() {
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+    return (std::uint64_t)ts.tv_sec * 1000000000ull + (std::uint64_t)ts.tv_nsec;
+}
+
+void SystemMetrics::addBusyNs(std::uint64_t ns) {
+    if (ns == 0) return;
+    // 1 writer mỗi slot: load + store là đủ (như Metrics)
+    BusySlot* s = slotForThisThread();
+    s->ns.store(s->ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+}
+
+SystemMetrics::Snapshot SystemMetrics::snapshot() {
+    Snapshot s;
+    s.cpu = sampler.combined.load(std::memory_order_relaxed);
+    s.osCpu = sampler.osCpu.load(std::memory_order_relaxed);
+    s.busyPercent = sampler.busyPercent.load(std::memory_order_relaxed);
+    s.cpuLimit = sampler.cpuLimit.load(std::memory_order_relaxed);
+    s.cgroup = sampler.cgroup.load(std::memory_order_relaxed);
+    s.periodMs = sampler.periodMs.load(std::memory_order_relaxed);
+    return s;
 }
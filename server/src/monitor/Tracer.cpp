@@ -0,0 +1,204 @@
+#include "monitor/Tracer.hpp"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<TraceEvent>::value, "TraceEvent goes through a seqlock slot");
+static_assert(sizeof(TraceEvent) % sizeof(std::uint64_t) == 0, "TraceEvent is copied word by word");
+
+std::atomic<bool> Tracer::enabled_{false};
+
+static thread_local const char* tlsThreadName = "thread";
+
+// Slot = seq + event dạng word atomic (như mailbox của AIPredictor):
+// seq lẻ = đang ghi, seq = 2*pos+2 = event thứ pos đã ghi xong
+struct Tracer::Ring {
+    static constexpr std::size_t WORDS = sizeof(TraceEvent) / sizeof(std::uint64_t);
+
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<std::uint64_t> words[WORDS];
+    };
+
+    Ring(std::size_t capacity, const char* name)
+        : slots(new Slot[capacity]), mask(capacity - 1), tid((std::uint32_t)syscall(SYS_gettid)),
+          threadName(name) {}
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    std::atomic<std::uint64_t> head{0};  // chỉ thread chủ ghi
+    std::uint32_t tid;
+    const char* threadName;
+};
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::enable(std::size_t eventsPerThread) {
+    std::size_t cap = 64;
+    while (cap < eventsPerThread) cap <<= 1;
+    std::size_t expected = 0;
+    capacity_.compare_exchange_strong(expected, cap, std::memory_order_relaxed);
+
+    enabled_.store(true, std::memory_order_release);
+    std::cout << "[TRACE] enabled: events/thread=" << capacity_.load(std::memory_order_relaxed) << "\n";
+}
+
+void Tracer::disable() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const char* name) {
+    tlsThreadName = name;
+}
+
+Tracer::Ring* Tracer::ringForThisThread() {
+    thread_local Ring* cached = nullptr;
+    if (cached) return cached;
+
+    auto ring = std::make_unique<Ring>(capacity_.load(std::memory_order_relaxed), tlsThreadName);
+    cached = ring.get();
+    std::lock_guard<std::mutex> lock(ringsMtx_);
+    rings_.push_back(std::move(ring));
+    return cached;
+}
+
+static std::uint64_t toNs(Tracer::TimePoint t) {
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+void Tracer::record(char phase, const char* cat, const char* name, TimePoint start, TimePoint end,
+                    std::uint64_t id, const TraceArg& a0, const TraceArg& a1, const TraceArg& a2) {
+    TraceEvent e;
+    e.cat = cat;
+    e.name = name;
+    e.tsNs = toNs(start);
+    e.durNs = end > start ? toNs(end) - e.tsNs : 0;
+    e.id = id;
+    e.args[0] = a0;
+    e.args[1] = a1;
+    e.args[2] = a2;
+    e.phase = (std::uint64_t)phase;
+
+    Ring* r = ringForThisThread();
+    std::uint64_t pos = r->head.load(std::memory_order_relaxed);
+    Ring::Slot& s = r->slots[pos & r->mask];
+
+    std::uint64_t buf[Ring::WORDS];
+    std::memcpy(buf, &e, sizeof(e));
+
+    s.seq.store(2 * pos + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < Ring::WORDS; ++i) s.words[i].store(buf[i], std::memory_order_relaxed);
+    s.seq.store(2 * pos + 2, std::memory_order_release);
+    r->head.store(pos + 1, std::memory_order_release);
+}
+
+// ---- dump ----
+
+static void appendf(std::string& out, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+static void appendf(std::string& out, const char* fmt, ...) {
+    char tmp[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n > 0) out.append(tmp, std::min<std::size_t>((std::size_t)n, sizeof(tmp) - 1));
+}
+
+static void appendArgs(std::string& out, const TraceEvent& e) {
+    out += ",\"args\":{";
+    bool first = true;
+    for (const TraceArg& a : e.args) {
+        if (!a.name) continue;
+        if (!first) out += ',';
+        first = false;
+        if (a.str) {
+            appendf(out, "\"%s\":\"%s\"", a.name, a.str);
+        } else {
+            appendf(out, "\"%s\":%" PRId64, a.name, a.num);
+        }
+    }
+    out += '}';
+}
+
+static void appendEvent(std::string& out, const TraceEvent& e, int pid, std::uint32_t tid) {
+    double ts = (double)e.tsNs / 1000.0;
+    char ph = (char)e.phase;
+
+    if (ph == 'A') {
+        // Async: cặp b/e cùng cat + name + id
+        appendf(out, ",\n{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"b\",\"id\":\"0x%" PRIx64
+                     "\",\"ts\":%.3f,\"pid\":%d,\"tid\":%u",
+                e.cat, e.name, e.id, ts, pid, tid);
+        appendArgs(out, e);
+        appendf(out, "},\n{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"e\",\"id\":\"0x%" PRIx64
+                     "\",\"ts\":%.3f,\"pid\":%d,\"tid\":%u}",
+                e.cat, e.name, e.id, ts + (double)e.durNs / 1000.0, pid, tid);
+        return;
+    }
+
+    appendf(out, ",\n{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%u",
+            e.cat, e.name, ph, ts, pid, tid);
+    if (ph == 'X') appendf(out, ",\"dur\":%.3f", (double)e.durNs / 1000.0);
+    if (ph == 'i') out += ",\"s\":\"t\"";
+    appendArgs(out, e);
+    out += '}';
+}
+
+std::string Tracer::dumpJson() const {
+    int pid = (int)getpid();
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    appendf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"http_server\"}}", pid);
+
+    std::lock_guard<std::mutex> lock(ringsMtx_);
+    for (const auto& r : rings_) {
+        appendf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                pid, r->tid, r->threadName);
+
+        std::uint64_t head = r->head.load(std::memory_order_acquire);
+        std::uint64_t cap = r->mask + 1;
+        std::uint64_t from = head > cap ? head - cap : 0;
+
+        std::uint64_t buf[Ring::WORDS];
+        for (std::uint64_t pos = from; pos < head; ++pos) {
+            const Ring::Slot& s = r->slots[pos & r->mask];
+            std::uint64_t s1 = s.seq.load(std::memory_order_acquire);
+            if (s1 != 2 * pos + 2) continue;  // đã bị ghi đè / đang ghi
+            for (std::size_t i = 0; i < Ring::WORDS; ++i) buf[i] = s.words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) != s1) continue;
+
+            TraceEvent e;
+            std::memcpy(&e, buf, sizeof(e));
+            appendEvent(out, e, pid, r->tid);
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+Tracer::Stats Tracer::stats() const {
+    Stats s;
+    s.enabled = enabled();
+    s.eventsPerThread = capacity_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(ringsMtx_);
+    s.threads = rings_.size();
+    for (const auto& r : rings_) {
+        std::uint64_t head = r->head.load(std::memory_order_relaxed);
+        s.recorded += head;
+        if (head > r->mask + 1) s.overwritten += head - (r->mask + 1);
+    }
+    return s;
+}
@@ -1,9 +1,6 @@
 #include "scheduler/AdaptiveScheduler.hpp"
-#include "scheduler/FIFOScheduler.hpp"
-#include "scheduler/SJFScheduler.hpp"
-#include "scheduler/RRScheduler.hpp"
-#include "scheduler/WFQScheduler.hpp"
 #include "monitor/SystemMetrics.hpp"
+#include "monitor/Tracer.hpp"
 
 #include <numeric>
 #include <algorithm>
@@ -21,23 +18,18 @@ static constexpr int WORKLOAD_WINDOW = 40;
 // ================================
 //  Constructor
 // ================================
-AdaptiveScheduler::AdaptiveScheduler() {
-    algoName_ = "FIFO";
-    inner_    = std::make_unique<FIFOScheduler>();
-
-    ai_ = std::make_unique<AIClient>(
-        "http://127.0.0.1:5000/predict",  // AI server
-        200                               // timeout ms
-    );
+AdaptiveScheduler::AdaptiveScheduler()
+    : queue_(RR_TIMESLICE_DEFAULT), model_(TreeModel::shared()) {
+    // Có model nhúng thì không cần thread gọi AI server
+    if (!model_->loaded()) predictor_ = AIPredictor::shared();
 }
 
 
 // ================================
 //  current algo
 // ================================
-std::string AdaptiveScheduler::currentAlgorithm() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return algoName_;
+SchedAlgo AdaptiveScheduler::currentAlgorithm() const {
+    return algo_.load(std::memory_order_relaxed);
 }
 
 
@@ -65,52 +57,40 @@ double AdaptiveScheduler::workloadVariability() {
 // ================================
 //  Adaptive decision
 // ================================
-std::string AdaptiveScheduler::decideAlgorithm(double cpu,
+SchedAlgo AdaptiveScheduler::decideAlgorithm(double cpu,
                                                std::size_t qlen,
                                                double wvar)
 {
     // 1) Load rất nhỏ → FIFO
     if (qlen < 20 && cpu < 40.0) {
-        return "FIFO";
+        return SchedAlgo::FIFO;
     }
 
     // 2) Workload ít biến thiên + CPU chưa quá cao → SJF
     if (wvar < 200.0 && cpu < 70.0) {
-        return "SJF";
+        return SchedAlgo::SJF;
     }
 
     // 3) CPU cao → RR (queue chưa phình to)
     if (cpu >= 70.0 && cpu < 85.0 && qlen < 200) {
-        return "RR";
+        return SchedAlgo::RR;
     }
 
     // 4) CPU rất cao + queue phình lớn → WFQ
     if (cpu >= 85.0 || qlen >= 200) {
-        return "WFQ";
+        return SchedAlgo::WFQ;
     }
 
     // fallback tự nhiên
-    return "SJF";
-}
-
-
-// ================================
-//  Scheduler factory
-// ================================
-std::unique_ptr<Scheduler> AdaptiveScheduler::make(const std::string& name) {
-    if (name == "FIFO") return std::make_unique<FIFOScheduler>();
-    if (name == "SJF")  return std::make_unique<SJFScheduler>();
-    if (name == "RR")   return std::make_unique<RRScheduler>(RR_TIMESLICE_DEFAULT);
-    if (name == "WFQ")  return std::make_unique<WFQScheduler>();
-    return std::make_unique<FIFOScheduler>();
+    return SchedAlgo::SJF;
 }
 
 
 // ================================
 //  enqueue(x): nơi quyết định thuật toán
 // ================================
-void AdaptiveScheduler::enqueue(const Task& t) {
-    enqueue(t, 0);
+void AdaptiveScheduler::enqueue(Task&& t) {
+    enqueue(std::move(t), 0);
 }
 
 static int computeQueueBin(std::size_t q) {
@@ -123,7 +103,7 @@ static int computeQueueBin(std::size_t q) {
     return 6;
 }
 
-void AdaptiveScheduler::enqueue(const Task& t, std::size_t queueLen) {
+void AdaptiveScheduler::enqueue(Task&& t, std::size_t queueLen) {
     double cpu = SystemMetrics::getCpuUsage();
 
      {
@@ -137,92 +117,76 @@ void AdaptiveScheduler::enqueue(const Task& t, std::size_t queueLen) {
     // lấy variance
     double wvar = workloadVariability();
 
-    std::string target;
-
-    if (aiEnabled_ && ai_) {
-        auto now = std::chrono::steady_clock::now();
-        if (lastAiCall_ == std::chrono::steady_clock::time_point{} ||
-            now - lastAiCall_ >= aiMinInterval_) {
-
-            lastAiCall_ = now;
-
-            AIFeatures f;
-            f.cpu = cpu;
-            f.queue_len = queueLen;
-            f.queue_bin = computeQueueBin(queueLen);
-            f.request_method = t.request_method;
-            f.request_path_length = t.request_path_length;
-            f.estimated_workload = static_cast<double>(t.estimatedTime);
-            f.req_size = t.req_size;
-
-            std::cout << "[AI] calling predict | cpu=" << cpu
-            << " q=" << queueLen
-            << " wvar=" << wvar
-            << " current=" << algoName_
-            << std::endl;
-
-            auto pred = ai_->predict(f);
-            if (pred && !pred->empty()) {
-                target = *pred;  // "SJF", "RR", "WFQ", ...
-            }
+    SchedAlgo target = algo_.load(std::memory_order_relaxed);
+    bool decided = false;
+
+    if (aiEnabled_) {
+        AIFeatures f;
+        f.cpu = cpu;
+        f.queue_len = queueLen;
+        f.queue_bin = computeQueueBin(queueLen);
+        f.request_method = httpMethodName(t.request_method);
+        f.request_path_length = t.request_path_length;
+        f.estimated_workload = static_cast<double>(t.estimatedTime);
+        f.req_size = t.req_size;
+
+        if (model_->loaded()) {
+            // Model nhúng: vài micro giây, ngay trên thread gọi
+            TraceScope span("ai", "model_predict");
+            decided = model_->predict(f, target);
+            if (decided) span.arg(0, {"algo", schedAlgoName(target)});
+        } else if (predictor_) {
+            // Không chờ AI server: gửi snapshot cho thread predictor, dùng khuyến nghị đã publish
+            TraceScope span("ai", "predictor_post");
+            predictor_->post(f);
+            decided = predictor_->recommendation(target);
+            span.arg(0, {"fresh", decided ? 1 : 0});
         }
     }
 
-    // fallback nếu AI fail
-    if (target.empty()) {
+    // fallback nếu AI fail / chưa có khuyến nghị mới
+    if (!decided) {
         target = decideAlgorithm(cpu, queueLen, wvar);
     }
 
     {
         std::lock_guard<std::mutex> lock(mtx_);
 
-        // nếu cần switch -> chuyển hết task sang scheduler mới
-        if (!target.empty() && target != algoName_) {
-            std::vector<Task> buf;
-            // drain toàn bộ task đang nằm trong inner_
-            while (inner_ && !inner_->empty()) {
-                buf.push_back(inner_->dequeue());
-            }
+        // switch: task đã nằm sẵn trong index của mọi policy, chỉ cần đổi algo_
+        SchedAlgo from = algo_.load(std::memory_order_relaxed);
+        if (target != from) {
+            algo_.store(target, std::memory_order_relaxed);
 
-            inner_ = make(target);
-            algoName_ = target;
+            // pending: task vẫn nằm nguyên, policy mới sẽ gặp entry stale của chúng khi pop
+            Tracer::instant("sched", "algo_switch", {"from", schedAlgoName(from)},
+                            {"to", schedAlgoName(target)});
 
-            // đẩy lại task vào scheduler mới
-            for (auto &x : buf) inner_->enqueue(x);
+            ++switches_;
+            stalePopsAtSwitch_ = queue_.stalePops();
+            compactionNsAtSwitch_ = queue_.compactionNs();
         }
 
-
-        if (!inner_) {
-            inner_ = std::make_unique<FIFOScheduler>();
-            algoName_ = "FIFO";
-        }
         std::cout << "[SCHED] q=" << queueLen << " cpu=" << cpu
-          << " target=" << target
-          << " current=" << algoName_ << "\n";
-
-        inner_->enqueue(t);  
+          << " target=" << schedAlgoName(target)
+          << " current=" << schedAlgoName(algo_.load(std::memory_order_relaxed)) << "\n";
     }
 
+    LockedScheduler::enqueue(std::move(t));
 }
 
 
 // ================================
-//  dequeue
+//  Thống kê switch
 // ================================
-Task AdaptiveScheduler::dequeue() {
+AdaptiveScheduler::SwitchStats AdaptiveScheduler::switchStats() const {
     std::lock_guard<std::mutex> lock(mtx_);
-    if (!inner_) return Task{};
-    return inner_->dequeue();
+    SwitchStats s;
+    s.switches = switches_;
+    s.stalePops = queue_.stalePops();
+    s.stalePopsSinceSwitch = s.stalePops - stalePopsAtSwitch_;
+    s.compactions = queue_.compactions();
+    s.compactionNs = queue_.compactionNs();
+    s.compactionNsSinceSwitch = s.compactionNs - compactionNsAtSwitch_;
+    s.pending = queue_.size();
+    return s;
 }
-
-
-
-// ================================
-//  empty()
-// ================================
-bool AdaptiveScheduler::empty() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (!inner_) return true;
-    return inner_->empty();
-}
-
@@ -0,0 +1,65 @@
+#include "scheduler/EventCount.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <time.h>
+
+#include <climits>
+
+static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t),
+              "futex needs the raw 32-bit half of the state word");
+
+static long futex(std::uint32_t* addr, int op, std::uint32_t val,
+                  const timespec* timeout = nullptr) {
+    return syscall(SYS_futex, addr, op, val, timeout, nullptr, 0);
+}
+
+std::uint32_t* EventCount::epochWord() {
+    auto* words = reinterpret_cast<std::uint32_t*>(&state);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return words + 1;
+#else
+    return words;
+#endif
+}
+
+void EventCount::wait(Key key) {
+    // Kernel tự so sánh epoch với key: notify chen vào giữa -> FUTEX_WAIT trả EAGAIN ngay
+    while (static_cast<Key>(state.load(std::memory_order_acquire) >> 32) == key) {
+        futex(epochWord(), FUTEX_WAIT_PRIVATE, key);
+    }
+}
+
+bool EventCount::waitFor(Key key, std::chrono::nanoseconds timeout) {
+    using Clock = std::chrono::steady_clock;
+    auto deadline = Clock::now() + timeout;
+
+    while (static_cast<Key>(state.load(std::memory_order_acquire) >> 32) == key) {
+        auto left = deadline - Clock::now();
+        if (left <= std::chrono::nanoseconds::zero()) {
+            cancelWait(key);
+            return false;
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+        timespec ts{static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+        futex(epochWord(), FUTEX_WAIT_PRIVATE, key, &ts);
+    }
+    return true;
+}
+
+void EventCount::notify(bool all) {
+    // Ghép với fence trong prepareWait(): hoặc thấy waiter, hoặc waiter thấy dữ liệu mới
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::uint64_t cur = state.load(std::memory_order_relaxed);
+    while (true) {
+        std::uint64_t waiters = cur & 0xffffffffu;
+        if (waiters == 0) return;
+
+        std::uint64_t next = cur + ONE_EPOCH - (all ? waiters : ONE_WAITER);
+        if (state.compare_exchange_weak(cur, next, std::memory_order_acq_rel)) break;
+    }
+    futex(epochWord(), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1);
+}
@@ -0,0 +1,140 @@
+#include "scheduler/MultiPolicyQueue.hpp"
+#include "monitor/Tracer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+// Index được phép dài gấp đôi số task còn sống (+ ngưỡng nhỏ) trước khi build lại
+static constexpr std::size_t COMPACT_SLACK = 64;
+
+void MultiPolicyQueue::push(Task&& task) {
+    // WFQ finish tag tính ngay lúc vào, dù policy hiện tại là gì
+    double lastFinish = lastFinishTime_[task.weight];
+    double start = std::max(lastFinish, virtualTime_);
+    double finish = start + (double)task.estimatedTime / std::max(1, (int)task.weight);
+    lastFinishTime_[task.weight] = finish;
+    task.finishTag = finish;
+
+    std::uint32_t slot;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+        tasks_[slot] = std::move(task);
+    } else {
+        slot = (std::uint32_t)tasks_.size();
+        tasks_.push_back(std::move(task));
+        gen_.push_back(0);
+    }
+
+    const Task& t = tasks_[slot];
+    Ref ref{slot, gen_[slot]};
+    std::uint64_t seq = seq_++;
+
+    fifo_.push_back(ref);
+    rr_.push_back(ref);
+    sjf_.push_back({(double)t.estimatedTime, seq, ref});
+    std::push_heap(sjf_.begin(), sjf_.end(), Later{});
+    wfq_.push_back({t.finishTag, seq, ref});
+    std::push_heap(wfq_.begin(), wfq_.end(), Later{});
+
+    ++live_;
+}
+
+Task MultiPolicyQueue::pop(SchedAlgo policy) {
+    if (live_ == 0) return Task{};
+
+    Ref r;
+    switch (policy) {
+    case SchedAlgo::SJF:
+        r = popHeap(sjf_);
+        break;
+    case SchedAlgo::WFQ:
+        r = popHeap(wfq_);
+        virtualTime_ = tasks_[r.slot].finishTag;
+        break;
+    case SchedAlgo::RR:
+        r = popRr();
+        break;
+    default:
+        r = popFifo();
+        break;
+    }
+
+    Task t = release(r);
+    maybeCompact();
+    return t;
+}
+
+Task MultiPolicyQueue::release(Ref r) {
+    Task t = std::move(tasks_[r.slot]);
+    ++gen_[r.slot];  // mọi entry còn trỏ tới slot này thành stale
+    free_.push_back(r.slot);
+    --live_;
+    return t;
+}
+
+MultiPolicyQueue::Ref MultiPolicyQueue::popFifo() {
+    while (!alive(fifo_.front())) {
+        fifo_.pop_front();
+        ++stalePops_;
+    }
+    Ref r = fifo_.front();
+    fifo_.pop_front();
+    return r;
+}
+
+MultiPolicyQueue::Ref MultiPolicyQueue::popRr() {
+    // Quantum mô phỏng trên queue (xem RRScheduler): task dài hơn slice bị trừ và xoay xuống cuối
+    while (true) {
+        Ref r = rr_.front();
+        rr_.pop_front();
+        if (!alive(r)) {
+            ++stalePops_;
+            continue;
+        }
+
+        Task& t = tasks_[r.slot];
+        if (t.remainingTime > rrTimeSlice_) {
+            t.remainingTime -= rrTimeSlice_;
+            rr_.push_back(r);
+            continue;
+        }
+        t.remainingTime = 0;
+        return r;
+    }
+}
+
+MultiPolicyQueue::Ref MultiPolicyQueue::popHeap(std::vector<KeyedRef>& heap) {
+    while (true) {
+        std::pop_heap(heap.begin(), heap.end(), Later{});
+        Ref r = heap.back().ref;
+        heap.pop_back();
+        if (alive(r)) return r;
+        ++stalePops_;
+    }
+}
+
+void MultiPolicyQueue::maybeCompact() {
+    std::size_t limit = 2 * live_ + COMPACT_SLACK;
+    if (fifo_.size() <= limit && rr_.size() <= limit && sjf_.size() <= limit &&
+        wfq_.size() <= limit) {
+        return;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto dead = [this](const Ref& r) { return !alive(r); };
+    auto deadKeyed = [this](const KeyedRef& k) { return !alive(k.ref); };
+
+    if (fifo_.size() > limit) fifo_.erase(std::remove_if(fifo_.begin(), fifo_.end(), dead), fifo_.end());
+    if (rr_.size() > limit) rr_.erase(std::remove_if(rr_.begin(), rr_.end(), dead), rr_.end());
+    for (auto* heap : {&sjf_, &wfq_}) {
+        if (heap->size() <= limit) continue;
+        heap->erase(std::remove_if(heap->begin(), heap->end(), deadKeyed), heap->end());
+        std::make_heap(heap->begin(), heap->end(), Later{});
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    ++compactions_;
+    compactionNs_ += (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    Tracer::complete("sched", "queue_compact", t0, t1, {"live", (std::int64_t)live_});
+}
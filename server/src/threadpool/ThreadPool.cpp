@@ -1,4 +1,9 @@
 #include "threadpool/ThreadPool.hpp"
+#include "threadpool/ChaseLevDeque.hpp"
+#include "scheduler/MpmcRing.hpp"
+#include "scheduler/SchedulerFactory.hpp"
+#include "monitor/Tracer.hpp"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -16,6 +21,42 @@ static inline long long nowMs() {
               << msg << std::endl;
 
 
+// =======================
+//  State riêng 1 worker (work-stealing)
+// =======================
+struct ThreadPool::Worker {
+    static constexpr std::size_t INBOX_CAPACITY = 4096;
+    static constexpr std::size_t SLOTS = 16;
+    static constexpr std::size_t REFILL_BATCH = 8;
+
+    // Thứ tự trong worker theo policy (FIFO/SJF/RR/WFQ/Adaptive). Owner nạp vào,
+    // owner và thief đều lấy ra được (scheduler nào cũng thread-safe)
+    std::unique_ptr<Scheduler> policy;
+
+    // Acceptor đẩy vào đây (lock-free), owner chuyển dần sang policy; thief cũng lấy được.
+    // Mỗi lần refill chỉ chuyển tối đa REFILL_BATCH task: phần backlog còn lại ở inbox
+    MpmcRing<Task> inbox{INBOX_CAPACITY};
+
+    // Task nằm trong slot, deque chỉ giữ con trỏ (Chase-Lev cần phần tử copy nguyên tử).
+    // Slot rảnh lại khi người lấy (owner hoặc thief) đã move Task ra
+    ChaseLevDeque<Task*> deque{SLOTS};
+    Task slots[SLOTS];
+    std::atomic<bool> slotBusy[SLOTS]{};
+
+    std::atomic<std::uint64_t> executed{0};
+    std::atomic<std::uint64_t> stolen{0};
+
+    Task take(Task* p) {
+        Task t = std::move(*p);
+        slotBusy[p - slots].store(false, std::memory_order_release);
+        return t;
+    }
+};
+
+// Worker đang chạy trên thread hiện tại (để currentAlgorithm() trả policy của chính nó)
+static thread_local const ThreadPool* tlsPool = nullptr;
+static thread_local std::size_t tlsWorker = 0;
+
 ThreadPool::ThreadPool(int threads, Scheduler* scheduler)
     : scheduler(scheduler), stop(false)
 {
@@ -30,11 +71,29 @@ ThreadPool::ThreadPool(int threads, Scheduler* scheduler)
     }
 }
 
+ThreadPool::ThreadPool(int threads, const std::string& algo) {
+    for (int i = 0; i < threads; ++i) {
+        locals.push_back(std::make_unique<Worker>());
+        locals.back()->policy = SchedulerFactory::create(algo);
+    }
+
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i]() {
+            stealingLoop((std::size_t)i);
+        });
+    }
+}
+
 ThreadPool::~ThreadPool() {
     stop.store(true, std::memory_order_relaxed);
 
-    // Ở thiết kế hiện tại, scheduler->dequeue() có thể block hoặc không.
-    // Nếu không block và trả Task “rỗng” khi hết việc, bạn có thể break loop phía dưới.
+    // close() đánh thức worker đang chờ trong scheduler -> join không bị treo
+    if (workStealing()) {
+        idle.notifyAll();
+    } else {
+        scheduler->close();
+    }
+
     for (auto& w : workers) {
         if (w.joinable()) {
             w.join();
@@ -43,30 +102,158 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::workerLoop() {
-    while (true) {
-        Task t;
+    Tracer::setThreadName("worker");
+    Task batch[MAX_BATCH];
 
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            cv.wait(lock, [this]() {
-                bool ready = stop.load(std::memory_order_relaxed) || !scheduler->empty();
-                return ready;
-            });
-            if (stop.load(std::memory_order_relaxed)) {
-                return;
-            }
-            t = scheduler->dequeue();
+    while (!stop.load(std::memory_order_relaxed)) {
+        // Queue sâu -> lấy nhiều task 1 lần lock; nông -> 1 task để worker khác không rảnh.
+        // Chỉ khi policy cho phép (FIFO): task trong lô đã rời scheduler, với SJF/priority
+        // task ngắn tới sau sẽ không vượt được -> mỗi lần 1 task, phần còn lại để scheduler xếp
+        std::size_t want = 1;
+        if (scheduler->batchOrderSafe()) {
+            want = getPendingTaskCount() / std::max<std::size_t>(1, workers.size());
+            want = std::clamp<std::size_t>(want, 1, MAX_BATCH);
         }
 
-        if (t.fn) {
-            t.fn();
-        } else {
-            LOGT("⚠️ Got empty task (fn=null)");
+        auto t0 = Tracer::enabled() ? Tracer::Clock::now() : Tracer::TimePoint{};
+        std::size_t n = scheduler->dequeueBatch(batch, want, IDLE_WAIT);
+        if (n) Tracer::complete("sched", "dequeue", t0, Tracer::Clock::now(), {"tasks", (std::int64_t)n});
+        for (std::size_t i = 0; i < n; ++i) {
+            runTask(batch[i]);
+            batch[i] = Task{};
+        }
+    }
+}
+
+// =======================
+//  Submit / work-stealing
+// =======================
+bool ThreadPool::trySubmit(Task& task, std::size_t queueLen) {
+    if (!workStealing()) return scheduler->tryEnqueue(task, queueLen);
+
+    // Round-robin; inbox đầy thì thử worker kế tiếp, tất cả đầy -> báo quá tải
+    std::size_t n = locals.size();
+    std::size_t start = nextWorker.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (locals[(start + i) % n]->inbox.tryPush(task)) {
+            // Worker nào dậy cũng được: owner bận thì worker rảnh sẽ steal từ inbox
+            idle.notifyOne();
+            return true;
+        }
+    }
+    return false;
+}
+
+SchedAlgo ThreadPool::currentAlgorithm() const {
+    if (!workStealing()) return scheduler->currentAlgorithm();
+    std::size_t i = (tlsPool == this) ? tlsWorker : 0;
+    return locals[i]->policy->currentAlgorithm();
+}
+
+ThreadPool::StealStats ThreadPool::stealStats() const {
+    StealStats s;
+    s.workers = locals.size();
+    for (const auto& w : locals) {
+        s.executed += w->executed.load(std::memory_order_relaxed);
+        s.stolen += w->stolen.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+std::vector<const Scheduler*> ThreadPool::schedulers() const {
+    std::vector<const Scheduler*> out;
+    if (scheduler) out.push_back(scheduler);
+    for (const auto& w : locals) out.push_back(w->policy.get());
+    return out;
+}
+
+void ThreadPool::runTask(Task& t) {
+    if (t.fn) {
+        t.fn();
+    } else {
+        LOGT("⚠️ Got empty task (fn=null)");
+    }
+    pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Tối đa 1 lô inbox -> policy, rồi 1 lô theo thứ tự policy -> deque. false nếu không có gì.
+// Không dồn cả inbox vào policy: owner đang chạy task dài thì backlog vẫn nằm chỗ thief thấy
+bool ThreadPool::refill(Worker& w) {
+    Task t;
+    for (std::size_t moved = 0; moved < Worker::REFILL_BATCH && w.inbox.tryPop(t); ++moved) {
+        w.policy->enqueue(std::move(t), getPendingTaskCount());
+    }
+    if (w.policy->empty()) return false;
+
+    Task* batch[Worker::REFILL_BATCH];
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < Worker::SLOTS && n < Worker::REFILL_BATCH; ++i) {
+        if (w.slotBusy[i].load(std::memory_order_acquire)) continue;  // thief chưa move xong
+        if (!w.policy->tryDequeue(w.slots[i])) break;
+        w.slotBusy[i].store(true, std::memory_order_relaxed);
+        batch[n++] = &w.slots[i];
+    }
+
+    // Đẩy ngược: task ưu tiên nhất nằm ở đáy (owner pop trước),
+    // task kém ưu tiên nhất ở đỉnh (thief lấy trước)
+    for (std::size_t i = n; i-- > 0;) w.deque.push(batch[i]);
+    return n > 0;
+}
+
+bool ThreadPool::trySteal(std::size_t self, Task& out) {
+    std::size_t n = locals.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        Worker& victim = *locals[(self + k) % n];
+
+        Task* p;
+        if (victim.deque.steal(p)) {
+            out = victim.take(p);
+            return true;
         }
-        pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+        // Owner đang bận task dài: lấy task đã vào policy (đúng thứ tự policy của nó),
+        // rồi tới task chưa kịp vào policy
+        if (victim.policy->tryDequeue(out)) return true;
+        if (victim.inbox.tryPop(out)) return true;
+    }
+    return false;
+}
+
+bool ThreadPool::hasWork() const {
+    // Mọi chỗ trySteal()/refill() lấy được: inbox, deque và policy của từng worker
+    for (const auto& w : locals) {
+        if (w->inbox.sizeApprox() > 0 || w->deque.sizeApprox() > 0 || !w->policy->empty()) return true;
     }
+    return false;
 }
 
+void ThreadPool::stealingLoop(std::size_t self) {
+    tlsPool = this;
+    tlsWorker = self;
+    Tracer::setThreadName("worker");
+    Worker& w = *locals[self];
 
+    while (!stop.load(std::memory_order_relaxed)) {
+        Task t;
+        Task* p;
 
+        if (w.deque.pop(p)) {
+            t = w.take(p);
+        } else if (refill(w)) {
+            continue;
+        } else if (trySteal(self, t)) {
+            w.stolen.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            // Không còn việc ở đâu: park tới khi có submit
+            EventCount::Key key = idle.prepareWait();
+            if (stop.load(std::memory_order_relaxed) || hasWork()) {
+                idle.cancelWait(key);
+                continue;
+            }
+            idle.wait(key);
+            continue;
+        }
 
+        runTask(t);
+        w.executed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
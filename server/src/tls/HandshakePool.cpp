@@ -0,0 +1,250 @@
+#include "tls/HandshakePool.hpp"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <iostream>
+
+#include "core/Reactor.hpp"
+#include "monitor/Tracer.hpp"
+
+// OpenSSL
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+static constexpr int MAX_EVENTS = 128;
+
+HandshakePool::HandshakePool(int threads, int timeoutSec) : timeoutSec(timeoutSec) {
+    if (threads < 1) threads = 1;
+
+    for (int i = 0; i < threads; ++i) {
+        auto w = std::make_unique<Worker>();
+        w->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        w->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = w->wakeFd;
+        epoll_ctl(w->epollFd, EPOLL_CTL_ADD, w->wakeFd, &ev);
+
+        workers.push_back(std::move(w));
+    }
+
+    for (auto& w : workers) {
+        Worker* wp = w.get();
+        w->thread = std::thread([this, wp]() { run(*wp); });
+    }
+
+    std::cout << "[TLS] Handshake pool: threads=" << threads << "\n";
+}
+
+HandshakePool::~HandshakePool() {
+    stop();
+    for (auto& w : workers) {
+        if (w->thread.joinable()) w->thread.join();
+        w->active.clear();
+        w->incoming.clear();
+        if (w->wakeFd >= 0) ::close(w->wakeFd);
+        if (w->epollFd >= 0) ::close(w->epollFd);
+    }
+}
+
+void HandshakePool::stop() {
+    running.store(false);
+    for (auto& w : workers) {
+        uint64_t one = 1;
+        ssize_t n = ::write(w->wakeFd, &one, sizeof(one));
+        (void)n;
+    }
+}
+
+void HandshakePool::submit(std::shared_ptr<Connection> conn, Reactor* owner) {
+    if (!running.load()) {
+        conn->close();
+        return;
+    }
+
+    std::size_t d = depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::size_t peak = peakDepth.load(std::memory_order_relaxed);
+    while (d > peak && !peakDepth.compare_exchange_weak(peak, d, std::memory_order_relaxed)) {
+    }
+
+    // Round-robin giữa các worker
+    Worker& w = *workers[nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size()];
+
+    Pending p;
+    p.conn = std::move(conn);
+    p.owner = owner;
+    p.queuedAt = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(w.mtx);
+        w.incoming.push_back(std::move(p));
+    }
+
+    uint64_t one = 1;
+    ssize_t n = ::write(w.wakeFd, &one, sizeof(one));
+    (void)n;
+}
+
+HandshakePool::Stats HandshakePool::stats() const {
+    Stats s{};
+    s.threads = workers.size();
+    s.queueDepth = depth.load(std::memory_order_relaxed);
+    s.peakQueueDepth = peakDepth.load(std::memory_order_relaxed);
+    s.completed = completed.load(std::memory_order_relaxed);
+    s.failed = failed.load(std::memory_order_relaxed);
+    s.timedOut = timedOut.load(std::memory_order_relaxed);
+    s.avgMs = s.completed ? (double)totalNs.load(std::memory_order_relaxed) / s.completed / 1e6
+                          : 0.0;
+    s.maxMs = (double)maxNs.load(std::memory_order_relaxed) / 1e6;
+    return s;
+}
+
+// =======================
+//  Worker loop
+// =======================
+void HandshakePool::run(Worker& w) {
+    Tracer::setThreadName("tls-handshake");
+    epoll_event events[MAX_EVENTS];
+    auto lastSweep = std::chrono::steady_clock::now();
+
+    while (running.load()) {
+        int n = epoll_wait(w.epollFd, events, MAX_EVENTS, 1000);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[TLS] handshake epoll_wait failed, errno=" << errno << "\n";
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == w.wakeFd) {
+                uint64_t v;
+                while (::read(w.wakeFd, &v, sizeof(v)) > 0) {}
+                adopt(w);
+                continue;
+            }
+
+            auto it = w.active.find(fd);
+            if (it == w.active.end()) continue;
+
+            if (events[i].events & EPOLLERR) {
+                finish(w, fd, Outcome::Failed);
+                continue;
+            }
+            drive(w, it->second);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep >= std::chrono::seconds(1)) {
+            sweep(w);
+            lastSweep = now;
+        }
+    }
+
+    // Dừng: đóng các handshake dang dở
+    for (auto& kv : w.active) kv.second.conn->close();
+    depth.fetch_sub(w.active.size(), std::memory_order_relaxed);
+    w.active.clear();
+}
+
+void HandshakePool::adopt(Worker& w) {
+    std::vector<Pending> batch;
+    {
+        std::lock_guard<std::mutex> lock(w.mtx);
+        batch.swap(w.incoming);
+    }
+
+    for (auto& p : batch) {
+        int fd = p.conn->fd;
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        epoll_ctl(w.epollFd, EPOLL_CTL_ADD, fd, &ev);
+        p.conn->epollEvents = EPOLLIN;
+
+        auto it = w.active.emplace(fd, std::move(p)).first;
+
+        // ClientHello thường đã tới cùng lúc với accept
+        drive(w, it->second);
+    }
+}
+
+bool HandshakePool::drive(Worker& w, Pending& p) {
+    Connection& conn = *p.conn;
+
+    int ret = SSL_accept(conn.ssl);
+    if (ret == 1) {
+        finish(w, conn.fd, Outcome::Done);
+        return false;
+    }
+
+    uint32_t want;
+    int err = SSL_get_error(conn.ssl, ret);
+    if (err == SSL_ERROR_WANT_READ) {
+        want = EPOLLIN;
+    } else if (err == SSL_ERROR_WANT_WRITE) {
+        want = EPOLLOUT;
+    } else {
+        std::cerr << "[SSL] SSL_accept failed\n";
+        ERR_print_errors_fp(stderr);
+        finish(w, conn.fd, Outcome::Failed);
+        return false;
+    }
+
+    if (conn.epollEvents != want) {
+        epoll_event ev{};
+        ev.events = want | EPOLLRDHUP;
+        ev.data.fd = conn.fd;
+        epoll_ctl(w.epollFd, EPOLL_CTL_MOD, conn.fd, &ev);
+        conn.epollEvents = want;
+    }
+    return true;
+}
+
+void HandshakePool::finish(Worker& w, int fd, Outcome outcome) {
+    auto it = w.active.find(fd);
+    if (it == w.active.end()) return;
+
+    Pending p = std::move(it->second);
+    w.active.erase(it);
+
+    // fd chuyển sang epoll của reactor
+    epoll_ctl(w.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    p.conn->epollEvents = 0;
+    depth.fetch_sub(1, std::memory_order_relaxed);
+
+    if (outcome != Outcome::Done) {
+        (outcome == Outcome::TimedOut ? timedOut : failed).fetch_add(1, std::memory_order_relaxed);
+        p.conn->close();
+        return;
+    }
+
+    auto ns = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - p.queuedAt)
+                  .count();
+    totalNs.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t prevMax = maxNs.load(std::memory_order_relaxed);
+    while (ns > prevMax && !maxNs.compare_exchange_weak(prevMax, ns, std::memory_order_relaxed)) {
+    }
+    completed.fetch_add(1, std::memory_order_relaxed);
+
+    p.conn->handshakeDoneAt = std::chrono::steady_clock::now();
+    Tracer::complete("net", "tls_handshake", p.conn->acceptedAt, p.conn->handshakeDoneAt,
+                     {"fd", p.conn->fd}, {"pooled", 1});
+    p.owner->resume(std::move(p.conn));
+}
+
+void HandshakePool::sweep(Worker& w) {
+    auto deadline = std::chrono::steady_clock::now() - std::chrono::seconds(timeoutSec);
+
+    std::vector<int> expired;
+    for (auto& kv : w.active) {
+        if (kv.second.queuedAt < deadline) expired.push_back(kv.first);
+    }
+    for (int fd : expired) finish(w, fd, Outcome::TimedOut);
+}
@@ -0,0 +1,290 @@
+#include "tls/TlsSessionCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+
+// OpenSSL
+#include <openssl/core_names.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+
+static const unsigned char SESSION_ID_CONTEXT[] = "http-ai-server";
+
+// Index ex_data để callback tìm lại TlsSessionCache từ SSL_CTX
+static int cacheExIndex() {
+    static int idx = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return idx;
+}
+
+TlsSessionCache::TlsSessionCache(std::size_t maxSessions, int ticketRotateSec)
+    : perShardCap(std::max<std::size_t>(1, maxSessions / SHARDS)),
+      ticketRotateSec(ticketRotateSec) {
+    if (ticketRotateSec > 0) {
+        TicketKey key;
+        if (makeKey(key)) {
+            keys.push_back(key);
+        } else {
+            std::cerr << "[TLS] Cannot generate session ticket key, tickets disabled\n";
+            this->ticketRotateSec = 0;
+        }
+    }
+}
+
+TlsSessionCache::~TlsSessionCache() {
+    // Xóa key khỏi bộ nhớ
+    for (auto& k : keys) {
+        OPENSSL_cleanse(k.aesKey.data(), k.aesKey.size());
+        OPENSSL_cleanse(k.hmacKey.data(), k.hmacKey.size());
+    }
+}
+
+void TlsSessionCache::attach(SSL_CTX* ctx, long sessionTimeoutSec) {
+    SSL_CTX_set_ex_data(ctx, cacheExIndex(), this);
+
+    SSL_CTX_set_session_id_context(ctx, SESSION_ID_CONTEXT, sizeof(SESSION_ID_CONTEXT) - 1);
+    SSL_CTX_set_timeout(ctx, sessionTimeoutSec);
+
+    // Chỉ dùng cache ngoài (cache nội bộ của OpenSSL khóa toàn cục)
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+    SSL_CTX_sess_set_new_cb(ctx, &TlsSessionCache::onNewSession);
+    SSL_CTX_sess_set_get_cb(ctx, &TlsSessionCache::onGetSession);
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    if (ticketRotateSec > 0) {
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &TlsSessionCache::onTicketKey);
+    } else {
+        // TLS 1.3 sẽ dùng ticket stateful -> đi qua session cache
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    }
+#else
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+#endif
+
+    std::cout << "[TLS] Session cache: shards=" << SHARDS << " cap=" << perShardCap * SHARDS
+              << " timeout=" << sessionTimeoutSec << "s"
+              << " tickets=" << (ticketRotateSec > 0 ? "on" : "off") << "\n";
+}
+
+TlsSessionCache::Stats TlsSessionCache::stats() const {
+    Stats s{};
+    s.cacheHits    = cacheHits.load(std::memory_order_relaxed);
+    s.cacheMisses  = cacheMisses.load(std::memory_order_relaxed);
+    s.cacheStored  = cacheStored.load(std::memory_order_relaxed);
+    s.cacheEvicted = cacheEvicted.load(std::memory_order_relaxed);
+    s.ticketIssued = ticketIssued.load(std::memory_order_relaxed);
+    s.ticketHits   = ticketHits.load(std::memory_order_relaxed);
+    s.ticketMisses = ticketMisses.load(std::memory_order_relaxed);
+    s.keyRotations = keyRotations.load(std::memory_order_relaxed);
+
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        s.sessions += shard.map.size();
+    }
+    return s;
+}
+
+// =======================
+//  Session-ID cache
+// =======================
+TlsSessionCache::Shard& TlsSessionCache::shardFor(const std::string& id) {
+    return shards[std::hash<std::string>{}(id) % SHARDS];
+}
+
+void TlsSessionCache::store(const std::string& id, std::string der, long timeoutSec) {
+    Shard& shard = shardFor(id);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+
+    auto it = shard.map.find(id);
+    if (it != shard.map.end()) {
+        shard.lru.erase(it->second.lruIt);
+        shard.map.erase(it);
+    }
+
+    // LRU: bỏ session cũ nhất khi shard đầy
+    while (shard.map.size() >= perShardCap && !shard.lru.empty()) {
+        shard.map.erase(shard.lru.back());
+        shard.lru.pop_back();
+        cacheEvicted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.lru.push_front(id);
+    Entry e;
+    e.der = std::move(der);
+    e.expires = std::chrono::steady_clock::now() + std::chrono::seconds(timeoutSec);
+    e.lruIt = shard.lru.begin();
+    shard.map.emplace(id, std::move(e));
+
+    cacheStored.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TlsSessionCache::lookup(const std::string& id, std::string& der) {
+    Shard& shard = shardFor(id);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+
+    auto it = shard.map.find(id);
+    if (it == shard.map.end()) return false;
+
+    if (it->second.expires < std::chrono::steady_clock::now()) {
+        shard.lru.erase(it->second.lruIt);
+        shard.map.erase(it);
+        return false;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruIt);
+    der = it->second.der;
+    return true;
+}
+
+TlsSessionCache* TlsSessionCache::fromSsl(SSL* ssl) {
+    return static_cast<TlsSessionCache*>(
+        SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), cacheExIndex()));
+}
+
+int TlsSessionCache::onNewSession(SSL* ssl, SSL_SESSION* sess) {
+    TlsSessionCache* self = fromSsl(ssl);
+    if (!self) return 0;
+
+    unsigned int idLen = 0;
+    const unsigned char* id = SSL_SESSION_get_id(sess, &idLen);
+    if (idLen == 0) return 0;
+
+    int derLen = i2d_SSL_SESSION(sess, nullptr);
+    if (derLen <= 0) return 0;
+
+    std::string der(static_cast<std::size_t>(derLen), '\0');
+    unsigned char* p = reinterpret_cast<unsigned char*>(&der[0]);
+    i2d_SSL_SESSION(sess, &p);
+
+    self->store(std::string(reinterpret_cast<const char*>(id), idLen), std::move(der),
+                SSL_SESSION_get_timeout(sess));
+
+    // 0 = không giữ reference tới sess (đã serialize)
+    return 0;
+}
+
+SSL_SESSION* TlsSessionCache::onGetSession(SSL* ssl, const unsigned char* id, int len,
+                                           int* copy) {
+    *copy = 0;
+    TlsSessionCache* self = fromSsl(ssl);
+    if (!self || len <= 0) return nullptr;
+
+    std::string der;
+    if (!self->lookup(std::string(reinterpret_cast<const char*>(id), len), der)) {
+        self->cacheMisses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(der.data());
+    SSL_SESSION* sess = d2i_SSL_SESSION(nullptr, &p, static_cast<long>(der.size()));
+    if (!sess) {
+        self->cacheMisses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    self->cacheHits.fetch_add(1, std::memory_order_relaxed);
+    return sess;
+}
+
+// =======================
+//  Session ticket keys
+// =======================
+bool TlsSessionCache::makeKey(TicketKey& key) {
+    key.created = std::chrono::steady_clock::now();
+    return RAND_bytes(key.name.data(), (int)key.name.size()) == 1 &&
+           RAND_bytes(key.aesKey.data(), (int)key.aesKey.size()) == 1 &&
+           RAND_bytes(key.hmacKey.data(), (int)key.hmacKey.size()) == 1;
+}
+
+void TlsSessionCache::rotateIfNeeded() {
+    auto now = std::chrono::steady_clock::now();
+    auto period = std::chrono::seconds(ticketRotateSec);
+    {
+        std::shared_lock<std::shared_mutex> lock(keyMtx);
+        if (!keys.empty() && now - keys.front().created < period) return;
+    }
+
+    TicketKey fresh;
+    if (!makeKey(fresh)) return;
+
+    std::unique_lock<std::shared_mutex> lock(keyMtx);
+    if (!keys.empty() && now - keys.front().created < period) return;  // thread khác đã xoay
+
+    // Giữ lại 1 key cũ để ticket vừa phát vẫn resume được (sẽ được cấp lại ticket mới)
+    keys.insert(keys.begin(), fresh);
+    while (keys.size() > 2) {
+        OPENSSL_cleanse(keys.back().aesKey.data(), keys.back().aesKey.size());
+        OPENSSL_cleanse(keys.back().hmacKey.data(), keys.back().hmacKey.size());
+        keys.pop_back();
+    }
+    keyRotations.fetch_add(1, std::memory_order_relaxed);
+}
+
+int TlsSessionCache::onTicketKey(SSL* ssl, unsigned char* keyName, unsigned char* iv,
+                                 EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int enc) {
+    TlsSessionCache* self = fromSsl(ssl);
+    if (!self) return -1;
+    return self->ticketCallback(keyName, iv, cipher, mac, enc);
+}
+
+int TlsSessionCache::ticketCallback(unsigned char* keyName, unsigned char* iv,
+                                    EVP_CIPHER_CTX* cipher, EVP_MAC_CTX* mac, int enc) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    auto setMac = [mac](const TicketKey& k) {
+        OSSL_PARAM params[3];
+        params[0] = OSSL_PARAM_construct_octet_string(
+            OSSL_MAC_PARAM_KEY, const_cast<unsigned char*>(k.hmacKey.data()), k.hmacKey.size());
+        params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                                     const_cast<char*>("SHA256"), 0);
+        params[2] = OSSL_PARAM_construct_end();
+        return EVP_MAC_CTX_set_params(mac, params) == 1;
+    };
+
+    if (enc) {
+        rotateIfNeeded();
+
+        std::shared_lock<std::shared_mutex> lock(keyMtx);
+        if (keys.empty()) return -1;
+        const TicketKey& k = keys.front();
+
+        std::memcpy(keyName, k.name.data(), k.name.size());
+        if (RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1) return -1;
+        if (EVP_EncryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, k.aesKey.data(), iv) != 1 ||
+            !setMac(k)) {
+            return -1;
+        }
+
+        ticketIssued.fetch_add(1, std::memory_order_relaxed);
+        return 1;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(keyMtx);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const TicketKey& k = keys[i];
+        if (std::memcmp(keyName, k.name.data(), k.name.size()) != 0) continue;
+
+        if (EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, k.aesKey.data(), iv) != 1 ||
+            !setMac(k)) {
+            return -1;
+        }
+
+        ticketHits.fetch_add(1, std::memory_order_relaxed);
+        // Ticket mã hóa bằng key cũ -> resume được nhưng cấp ticket mới
+        return i == 0 ? 1 : 2;
+    }
+
+    ticketMisses.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+#else
+    (void)keyName;
+    (void)iv;
+    (void)cipher;
+    (void)mac;
+    (void)enc;
+    return -1;
+#endif
+}
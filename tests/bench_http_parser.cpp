@@ -0,0 +1,149 @@
+// Microbenchmark: parser tăng dần (string_view + SIMD) vs parser istringstream cũ.
+// Chạy: ./bench_http_parser [iterations]
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/HttpParser.hpp"
+
+// =======================
+//  Parser cũ (giữ nguyên logic để so sánh)
+// =======================
+struct LegacyRequest {
+    std::string method;
+    std::string path;
+    std::string version;
+    std::unordered_map<std::string, std::string> headers;
+    std::string body;
+};
+
+static inline void trimCRLF(std::string& s) {
+    while (!s.empty() && (s.back() == '\r' || s.back() == '\n')) s.pop_back();
+}
+
+static LegacyRequest legacyParse(const std::string& raw) {
+    LegacyRequest req;
+    std::istringstream stream(raw);
+    std::string line;
+
+    if (std::getline(stream, line)) {
+        trimCRLF(line);
+        std::istringstream firstLine(line);
+        firstLine >> req.method >> req.path >> req.version;
+    }
+
+    while (std::getline(stream, line)) {
+        trimCRLF(line);
+        if (line.empty()) break;
+
+        auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+
+        std::string key = line.substr(0, colon);
+        std::string value = line.substr(colon + 1);
+        while (!value.empty() && value.front() == ' ') value.erase(value.begin());
+
+        trimCRLF(key);
+        trimCRLF(value);
+        req.headers[key] = value;
+    }
+
+    std::string body((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    req.body = body;
+    return req;
+}
+
+// Reactor cũ: find("\r\n\r\n") lại trên cả buffer sau mỗi lần đọc
+static std::size_t legacyFindHeaderEnd(const std::string& buf) {
+    std::size_t pos = buf.find("\r\n\r\n");
+    return pos == std::string::npos ? 0 : pos + 4;
+}
+
+// =======================
+//  Dữ liệu mẫu
+// =======================
+static const std::string SAMPLE =
+    "GET /api/file/reports/2024/summary.csv HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+    "Chrome/120.0.0.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.9,vi;q=0.8\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Cookie: session=4f9a1c2b7d8e6f5a3b2c1d0e9f8a7b6c; theme=dark; lang=vi\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n"
+    "Range: bytes=0-1023\r\n"
+    "\r\n";
+
+template <typename F>
+static double timeIt(int iterations, F&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 200000;
+
+    // Hai parser phải cho cùng kết quả
+    {
+        LegacyRequest a = legacyParse(SAMPLE);
+        HttpParser p;
+        assert(p.feed(SAMPLE) == HttpParser::Status::Done);
+        Request b = p.take();
+        b.raw = SAMPLE;
+        assert(a.method == b.method() && a.path == b.path() && a.version == b.version());
+        assert(a.headers.size() == b.headers.size());
+        for (const auto& h : a.headers) assert(h.second == b.header(h.first));
+        (void)a;
+    }
+
+    volatile std::size_t sink = 0;
+
+    // 1) Parse 1 request đã đủ trong buffer
+    double legacyNs = timeIt(iterations, [&]() {
+        LegacyRequest r = legacyParse(SAMPLE);
+        sink = sink + r.headers.size();
+    });
+    double newNs = timeIt(iterations, [&]() {
+        HttpParser p;
+        p.feed(SAMPLE);
+        Request r = p.take();
+        sink = sink + r.headers.size();
+    });
+
+    // 2) Request tới từng mảnh 16 byte (SSL_read nhỏ): cũ quét lại cả buffer mỗi lần
+    std::vector<std::string> prefixes;
+    for (std::size_t n = 16; n < SAMPLE.size(); n += 16) prefixes.push_back(SAMPLE.substr(0, n));
+    prefixes.push_back(SAMPLE);
+
+    double legacyIncNs = timeIt(iterations / 10, [&]() {
+        std::size_t end = 0;
+        for (const auto& buf : prefixes) {
+            end = legacyFindHeaderEnd(buf);
+            if (end) break;
+        }
+        LegacyRequest r = legacyParse(SAMPLE.substr(0, end));
+        sink = sink + r.headers.size();
+    });
+    double newIncNs = timeIt(iterations / 10, [&]() {
+        HttpParser p;
+        for (const auto& buf : prefixes) {
+            if (p.feed(buf) == HttpParser::Status::Done) break;
+        }
+        sink = sink + p.headerEnd();
+    });
+
+    std::cout << "[BENCH] request " << SAMPLE.size() << " bytes, " << iterations << " iterations\n";
+    std::cout << "[BENCH] full buffer : legacy " << legacyNs << " ns/req, incremental " << newNs
+              << " ns/req (x" << legacyNs / newNs << ")\n";
+    std::cout << "[BENCH] 16B chunks  : legacy " << legacyIncNs << " ns/req, incremental "
+              << newIncNs << " ns/req (x" << legacyIncNs / newIncNs << ")\n";
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Microbenchmark: FIFOScheduler trên MPMC ring vs queue + mutex/cv cũ (kèm mutex của ThreadPool).
+// Chạy: ./bench_mpmc_ring [tasks]
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "scheduler/FIFOScheduler.hpp"
+
+// =======================
+//  FIFO cũ: std::queue + mutex + cv, worker lấy thêm queueMutex của pool
+// =======================
+class LegacyFifo {
+public:
+    void enqueue(Task&& t) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            q.push(std::move(t));
+        }
+        cv.notify_one();
+    }
+
+    Task dequeue() {
+        std::lock_guard<std::mutex> poolLock(poolMtx);
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return !q.empty(); });
+        Task t = std::move(q.front());
+        q.pop();
+        return t;
+    }
+
+private:
+    std::mutex poolMtx;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::queue<Task> q;
+};
+
+template <typename Q>
+static double run(Q& q, int producers, int consumers, int tasks) {
+    std::atomic<long> done{0};
+    int perProducer = tasks / producers;
+    int total = perProducer * producers;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            // Chia đều số task cho consumer để mọi thread đều thoát
+            int mine = total / consumers + (c < total % consumers ? 1 : 0);
+            for (int i = 0; i < mine; ++i) {
+                Task t = q.dequeue();
+                t.fn();
+            }
+        });
+    }
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < perProducer; ++i) {
+                q.enqueue(Task((std::uint32_t)i, 1, 1, SchedAlgo::FIFO, HttpMethod::GET, 0, 0,
+                               [&done]() { done.fetch_add(1, std::memory_order_relaxed); }));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    auto t1 = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    return done.load() / sec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int tasks = argc > 1 ? std::stoi(argv[1]) : 400000;
+    const int configs[][2] = {{1, 1}, {1, 4}, {2, 4}, {4, 4}, {4, 8}};
+
+    std::cout << "[BENCH] " << tasks << " tasks, Mops/s (producers x consumers)\n";
+    for (const auto& cfg : configs) {
+        LegacyFifo legacy;
+        FIFOScheduler ring;
+        double a = run(legacy, cfg[0], cfg[1], tasks);
+        double b = run(ring, cfg[0], cfg[1], tasks);
+        std::cout << "[BENCH] " << cfg[0] << "x" << cfg[1] << " : mutex+cv " << a << ", mpmc ring "
+                  << b << " (x" << b / a << ")\n";
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "core/Response.hpp"
+
+// HTTP/1.0 stream (ChunkedWriter không chunked): body kết thúc bằng đóng connection,
+// header không được có Content-Length (client sẽ dừng đọc ở đó)
+int main() {
+    Response res;
+    res.headers["Connection"] = "close";
+    res.closeDelimited = true;
+    std::string head = res.build();
+    assert(head.find("Content-Length") == std::string::npos);
+    assert(head.find("Transfer-Encoding") == std::string::npos);
+    assert(head.size() >= 4 && head.compare(head.size() - 4, 4, "\r\n\r\n") == 0);
+
+    Response chunked;
+    chunked.chunked = true;
+    assert(chunked.build().find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+
+    Response plain;
+    plain.body = "hello";
+    std::string full = plain.build();
+    assert(full.find("Content-Length: 5\r\n") != std::string::npos);
+    assert(full.compare(full.size() - 5, 5, "hello") == 0);
+
+    // Header Connection dựng sẵn được ghi nguyên văn, trước dòng trống cuối header
+    static const std::string keepAliveLines = "Connection: keep-alive\r\nKeep-Alive: timeout=5, max=100\r\n";
+    Response ka;
+    ka.connectionHeaders = keepAliveLines;
+    std::string kaHead = ka.build();
+    assert(kaHead.find(keepAliveLines + "\r\n") != std::string::npos);
+
+    std::cout << "[TEST] Response framing OK\n";
+    return 0;
+}
@@ -1,7 +1,37 @@
 #include <cassert>
 #include <iostream>
+
+#include "scheduler/FIFOScheduler.hpp"
+
+static Task makeTask(std::uint32_t id, int& ran) {
+    return Task(id, 1, 1, SchedAlgo::FIFO, HttpMethod::GET, 0, 0, [&ran]() { ++ran; });
+}
+
+// Ring đầy: tryEnqueue trả false ngay (reactor không bị chặn), task vẫn ở caller
 int main() {
-    std::cout << "[TEST] Scheduler logic placeholder\\n";
-    assert(true);
+    int ran = 0;
+    FIFOScheduler sched(2);
+
+    Task a = makeTask(1, ran);
+    Task b = makeTask(2, ran);
+    Task c = makeTask(3, ran);
+    assert(sched.tryEnqueue(a, 0));
+    assert(sched.tryEnqueue(b, 1));
+    assert(!sched.tryEnqueue(c, 2));
+    assert(c.fn);
+
+    Task out;
+    assert(sched.tryDequeue(out));
+    out.fn();
+    assert(sched.tryEnqueue(c, 1));
+
+    while (sched.tryDequeue(out)) out.fn();
+    assert(ran == 3);
+
+    sched.close();
+    Task d = makeTask(4, ran);
+    assert(!sched.tryEnqueue(d, 0));
+
+    std::cout << "[TEST] FIFOScheduler tryEnqueue OK\n";
     return 0;
 }
@@ -1,7 +1,76 @@
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "scheduler/SJFScheduler.hpp"
+#include "threadpool/ThreadPool.hpp"
+
+// SJF với queue sâu: task ngắn tới sau phải chạy trước các task dài còn chờ,
+// worker không được giữ sẵn 1 lô task đã rời scheduler
+// Closure của Task phải nhỏ (InlineFunction): lambda chỉ giữ con trỏ tới state chung
+struct State {
+    ThreadPool* pool = nullptr;
+    std::mutex mtx;
+    std::vector<std::uint32_t> order;
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+
+    void submit(Task t) {
+        pool->incrementPendingTasks();
+        bool ok = pool->trySubmit(t, pool->getPendingTaskCount());
+        assert(ok);
+        (void)ok;
+    }
+    void record(std::uint32_t id) {
+        std::lock_guard<std::mutex> lock(mtx);
+        order.push_back(id);
+    }
+};
+
+static constexpr std::uint32_t LONG_TASKS = 20;
+static constexpr std::uint32_t SHORT_ID = 999;
+
+static Task makeTask(State* st, std::uint32_t id, int est) {
+    return Task(id, est, 1, SchedAlgo::SJF, HttpMethod::GET, 0, 0, [st, id]() {
+        st->record(id);
+        // Task dài đầu tiên đang chạy thì 1 task rất ngắn tới
+        if (id == 100) st->submit(makeTask(st, SHORT_ID, 1));
+    });
+}
+
 int main() {
-    std::cout << "[TEST] Threadpool logic placeholder\\n";
-    assert(true);
+    SJFScheduler sched;
+    ThreadPool pool(1, &sched);
+    State state;
+    State* st = &state;
+    st->pool = &pool;
+
+    // Giữ worker bận tới khi queue đã đầy task dài
+    st->submit(Task(0, 0, 1, SchedAlgo::SJF, HttpMethod::GET, 0, 0, [st]() {
+        st->started = true;
+        while (!st->release) std::this_thread::yield();
+    }));
+    while (!st->started) std::this_thread::yield();
+
+    for (std::uint32_t i = 0; i < LONG_TASKS; ++i) st->submit(makeTask(st, 100 + i, (int)(100 + i)));
+    st->release = true;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (pool.getPendingTaskCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::lock_guard<std::mutex> lock(st->mtx);
+    const auto& order = st->order;
+    assert(order.size() == LONG_TASKS + 1);
+    assert(order[0] == 100);
+    assert(order[1] == SHORT_ID);
+    for (std::size_t i = 2; i < order.size(); ++i) assert(order[i] == 100 + i - 1);
+
+    std::cout << "[TEST] ThreadPool keeps SJF order with a deep queue OK\n";
     return 0;
 }
@@ -0,0 +1,190 @@
+// log_export: đọc segment log nhị phân (mmap) -> CSV hoặc mảng theo cột
+//
+//   log_export [--csv FILE|-] <segment.bin | prefix> ...
+//   log_export --columns DIR <segment.bin | prefix> ...
+//
+// prefix (vd. data/logs/http_server_log) = mọi segment "<prefix>.NNNNNN.bin" theo thứ tự.
+// --columns ghi mỗi cột 1 file raw little-endian (numpy.fromfile(path, dtype)) + columns.json.
+#include "monitor/LogSegment.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void usage() {
+    std::cerr << "usage: log_export [--csv FILE|-] <segment.bin|prefix>...\n"
+                 "       log_export --columns DIR <segment.bin|prefix>...\n";
+}
+
+static std::vector<std::string> expandInputs(const std::vector<std::string>& args) {
+    std::vector<std::string> out;
+    for (const auto& a : args) {
+        if (std::filesystem::is_regular_file(a)) {
+            out.push_back(a);
+            continue;
+        }
+        auto segs = LogSegment::listSegments(a);
+        if (segs.empty()) std::cerr << "[LOG-EXPORT] no segment for " << a << std::endl;
+        out.insert(out.end(), segs.begin(), segs.end());
+    }
+    return out;
+}
+
+static bool exportCsv(const std::vector<std::string>& inputs, const std::string& outPath) {
+    FILE* out = outPath == "-" ? stdout : fopen(outPath.c_str(), "wb");
+    if (!out) {
+        std::cerr << "[LOG-EXPORT] cannot open " << outPath << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    std::string buf = LogSegment::CSV_HEADER;
+    buf.reserve(1 << 20);
+    std::size_t rows = 0;
+    for (const auto& path : inputs) {
+        LogSegment::Reader seg;
+        if (!seg.open(path)) continue;
+        for (std::size_t i = 0; i < seg.size(); ++i) {
+            seg.appendCsv(buf, i);
+            if (buf.size() >= (1 << 20) - 256) {
+                fwrite(buf.data(), 1, buf.size(), out);
+                buf.clear();
+            }
+        }
+        rows += seg.size();
+    }
+    fwrite(buf.data(), 1, buf.size(), out);
+
+    if (out != stdout) fclose(out);
+    std::cerr << "[LOG-EXPORT] " << rows << " rows from " << inputs.size() << " segment(s)" << std::endl;
+    return true;
+}
+
+// 1 cột = 1 file raw; dtype theo numpy
+struct Column {
+    const char* name;
+    const char* dtype;
+    std::size_t offset;
+    std::size_t size;
+    FILE* file = nullptr;
+};
+
+static bool exportColumns(const std::vector<std::string>& inputs, const std::string& dir) {
+    using R = LogSegment::Record;
+    std::vector<Column> cols = {
+        {"timestamp_ns", "<i8", offsetof(R, timestampNs), sizeof(R::timestampNs)},
+        {"cpu", "<f4", offsetof(R, cpu), sizeof(R::cpu)},
+        {"queue_len", "<u4", offsetof(R, queueLen), sizeof(R::queueLen)},
+        {"request_method", "u1", offsetof(R, method), sizeof(R::method)},
+        {"request_path_length", "<u4", offsetof(R, pathLength), sizeof(R::pathLength)},
+        {"estimated_workload", "<i4", offsetof(R, estimatedWorkload), sizeof(R::estimatedWorkload)},
+        {"algo_at_enqueue", "u1", offsetof(R, algoEnqueue), sizeof(R::algoEnqueue)},
+        {"algo_at_run", "u1", offsetof(R, algoRun), sizeof(R::algoRun)},
+        {"req_size", "<u4", offsetof(R, reqSize), sizeof(R::reqSize)},
+        {"response_ms", "<f4", offsetof(R, responseMs), sizeof(R::responseMs)},
+        {"latency_avg", "<f4", offsetof(R, latencyAvg), sizeof(R::latencyAvg)},
+        {"queue_ms", "<f4", offsetof(R, queueMs), sizeof(R::queueMs)},
+        {"service_ms", "<f4", offsetof(R, serviceMs), sizeof(R::serviceMs)},
+        {"write_ms", "<f4", offsetof(R, writeMs), sizeof(R::writeMs)},
+        {"handshake_ms", "<f4", offsetof(R, handshakeMs), sizeof(R::handshakeMs)},
+        {"read_ms", "<f4", offsetof(R, readMs), sizeof(R::readMs)},
+    };
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    for (auto& c : cols) {
+        std::string p = dir + "/" + c.name + ".bin";
+        c.file = fopen(p.c_str(), "wb");
+        if (!c.file) {
+            std::cerr << "[LOG-EXPORT] cannot open " << p << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    // Gom theo lô cho mỗi cột rồi fwrite 1 lần
+    static constexpr std::size_t BATCH = 65536;
+    std::vector<char> tmp(BATCH * sizeof(std::int64_t));
+    std::size_t rows = 0;
+    std::vector<std::string> methods, algos;
+
+    for (const auto& path : inputs) {
+        LogSegment::Reader seg;
+        if (!seg.open(path)) continue;
+        if (methods.empty()) {
+            for (std::uint8_t i = 0; i < LogSegment::DICT_SIZE; ++i) {
+                methods.push_back(seg.methodName(i));
+                algos.push_back(seg.algoName(i));
+            }
+        }
+
+        const char* base = reinterpret_cast<const char*>(seg.records());
+        for (std::size_t start = 0; start < seg.size(); start += BATCH) {
+            std::size_t n = std::min(BATCH, seg.size() - start);
+            for (auto& c : cols) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::memcpy(tmp.data() + i * c.size, base + (start + i) * sizeof(R) + c.offset, c.size);
+                }
+                fwrite(tmp.data(), c.size, n, c.file);
+            }
+        }
+        rows += seg.size();
+    }
+
+    for (auto& c : cols) fclose(c.file);
+
+    // Manifest: dtype từng cột + bảng mã method/algo
+    std::ofstream meta(dir + "/columns.json");
+    meta << "{\n  \"rows\": " << rows << ",\n  \"columns\": {";
+    for (std::size_t i = 0; i < cols.size(); ++i) {
+        meta << (i ? ",\n" : "\n") << "    \"" << cols[i].name << "\": \"" << cols[i].dtype << "\"";
+    }
+    auto list = [&meta](const std::vector<std::string>& v) {
+        meta << "[";
+        for (std::size_t i = 0; i < v.size(); ++i) meta << (i ? ", " : "") << "\"" << v[i] << "\"";
+        meta << "]";
+    };
+    meta << "\n  },\n  \"methods\": ";
+    list(methods);
+    meta << ",\n  \"algos\": ";
+    list(algos);
+    meta << "\n}\n";
+
+    std::cerr << "[LOG-EXPORT] " << rows << " rows -> " << dir << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string csvOut = "-";
+    std::string columnsDir;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--csv" && i + 1 < argc) {
+            csvOut = argv[++i];
+        } else if (a == "--columns" && i + 1 < argc) {
+            columnsDir = argv[++i];
+        } else if (a == "-h" || a == "--help") {
+            usage();
+            return 0;
+        } else {
+            args.push_back(a);
+        }
+    }
+    if (args.empty()) {
+        usage();
+        return 2;
+    }
+
+    auto inputs = expandInputs(args);
+    if (inputs.empty()) return 1;
+
+    bool ok = columnsDir.empty() ? exportCsv(inputs, csvOut) : exportColumns(inputs, columnsDir);
+    return ok ? 0 : 1;
+}